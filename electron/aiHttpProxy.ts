@@ -1,3 +1,5 @@
+import http from 'node:http'
+import https from 'node:https'
 import type { WebContents } from 'electron'
 import type {
   AIApiMode,
@@ -94,6 +96,120 @@ function buildAiHeaders(credential: ResolvedAICredential): Record<string, string
   }
 }
 
+// 按 origin 维护 keep-alive 连接池：聊天、嵌入、视觉请求都打向少数几个网关，
+// 复用已握手的连接能省掉每回合 ~200ms 的 TLS 握手 + 慢启动。统计 socket 复用率
+// 和握手次数供诊断（getPoolMetrics）。传输层用 node:http/https 内建 Agent——
+// HTTP/2 需要引入新依赖或手管 http2 会话，握手收益用 HTTP/1.1 keep-alive 已能拿到。
+const POOL_KEEP_ALIVE_MSECS = 30_000
+const POOL_MAX_SOCKETS_PER_ORIGIN = 8
+const POOL_MAX_FREE_SOCKETS_PER_ORIGIN = 4
+const WARMUP_TIMEOUT_MS = 10_000
+
+type AiPoolOriginMetrics = {
+  requests: number
+  reusedSockets: number
+  handshakes: number
+}
+
+export type AiPoolMetrics = {
+  origins: Record<string, AiPoolOriginMetrics>
+  totals: AiPoolOriginMetrics
+}
+
+class AiConnectionPool {
+  private readonly agents = new Map<string, http.Agent>()
+  private readonly metrics = new Map<string, AiPoolOriginMetrics>()
+
+  agentFor(endpoint: URL): http.Agent {
+    const origin = endpoint.origin
+    let agent = this.agents.get(origin)
+    if (!agent) {
+      const AgentCtor = endpoint.protocol === 'https:' ? https.Agent : http.Agent
+      agent = new AgentCtor({
+        keepAlive: true,
+        keepAliveMsecs: POOL_KEEP_ALIVE_MSECS,
+        maxSockets: POOL_MAX_SOCKETS_PER_ORIGIN,
+        maxFreeSockets: POOL_MAX_FREE_SOCKETS_PER_ORIGIN,
+        scheduling: 'lifo',
+      })
+      this.agents.set(origin, agent)
+    }
+    return agent
+  }
+
+  recordSocketAssignment(origin: string, reused: boolean): void {
+    let entry = this.metrics.get(origin)
+    if (!entry) {
+      entry = { requests: 0, reusedSockets: 0, handshakes: 0 }
+      this.metrics.set(origin, entry)
+    }
+    entry.requests += 1
+    if (reused) entry.reusedSockets += 1
+    else entry.handshakes += 1
+  }
+
+  snapshot(): AiPoolMetrics {
+    const origins: Record<string, AiPoolOriginMetrics> = {}
+    const totals: AiPoolOriginMetrics = { requests: 0, reusedSockets: 0, handshakes: 0 }
+    for (const [origin, entry] of this.metrics) {
+      origins[origin] = { ...entry }
+      totals.requests += entry.requests
+      totals.reusedSockets += entry.reusedSockets
+      totals.handshakes += entry.handshakes
+    }
+    return { origins, totals }
+  }
+
+  destroy(): void {
+    for (const agent of this.agents.values()) agent.destroy()
+    this.agents.clear()
+  }
+}
+
+type PooledResponse = {
+  ok: boolean
+  status: number
+  statusText: string
+  contentType: string
+  stream: http.IncomingMessage
+  text(): Promise<string>
+}
+
+function requestViaPool(
+  pool: AiConnectionPool,
+  endpoint: URL,
+  headers: Record<string, string>,
+  body: string,
+  signal: AbortSignal,
+): Promise<PooledResponse> {
+  return new Promise<PooledResponse>((resolve, reject) => {
+    const transport = endpoint.protocol === 'https:' ? https : http
+    const request = transport.request(
+      endpoint,
+      { method: 'POST', headers, agent: pool.agentFor(endpoint), signal },
+      (response) => {
+        const status = response.statusCode ?? 0
+        resolve({
+          ok: status >= 200 && status < 300,
+          status,
+          statusText: response.statusMessage ?? '',
+          contentType: String(response.headers['content-type'] ?? ''),
+          stream: response,
+          text: async () => {
+            const chunks: Buffer[] = []
+            for await (const chunk of response) chunks.push(Buffer.from(chunk))
+            return Buffer.concat(chunks).toString('utf8')
+          },
+        })
+      },
+    )
+    // 'socket' 在分配连接时触发；reusedSocket 标记该连接是否来自 keep-alive 空闲池
+    request.on('socket', () => pool.recordSocketAssignment(endpoint.origin, request.reusedSocket === true))
+    request.on('error', reject)
+    request.end(body)
+  })
+}
+
 function normalizeTimeoutMs(raw: unknown): number {
   const value = typeof raw === 'number' && Number.isFinite(raw) ? Math.trunc(raw) : DEFAULT_TIMEOUT_MS
   return Math.max(1_000, Math.min(10 * 60_000, value))
@@ -107,19 +223,10 @@ function serializeRequestBody(body: Record<string, unknown>): string {
   return serialized
 }
 
-async function readResponse(res: Response): Promise<AIHttpResponse> {
-  return {
-    ok: res.ok,
-    status: res.status,
-    statusText: res.statusText,
-    contentType: res.headers.get('content-type') ?? '',
-    bodyText: await res.text(),
-  }
-}
-
 export class AIHttpProxy {
   private readonly getSettings: () => AppSettings
   private readonly streams = new Map<string, ActiveStream>()
+  private readonly pool = new AiConnectionPool()
 
   constructor(getSettings: () => AppSettings) {
     this.getSettings = getSettings
@@ -132,18 +239,56 @@ export class AIHttpProxy {
     const abortController = new AbortController()
     const timer = setTimeout(() => abortController.abort(new Error('AI HTTP timeout')), normalizeTimeoutMs(payload.timeoutMs))
     try {
-      const response = await fetch(endpoint, {
-        method: 'POST',
-        headers: buildAiHeaders(credential),
-        body,
-        signal: abortController.signal,
-      })
-      return await readResponse(response)
+      const response = await requestViaPool(this.pool, endpoint, buildAiHeaders(credential), body, abortController.signal)
+      return {
+        ok: response.ok,
+        status: response.status,
+        statusText: response.statusText,
+        contentType: response.contentType,
+        bodyText: await response.text(),
+      }
     } finally {
       clearTimeout(timer)
     }
   }
 
+  /**
+   * 启动时预热主聊天端点：对 origin 发一个 HEAD 请求把 TCP+TLS 建好并停驻进
+   * keep-alive 池，首个聊天回合直接复用。凭据未配置或预热失败都静默跳过，
+   * 代价只是退回冷连接路径。
+   */
+  async warmUp(): Promise<void> {
+    let endpoint: URL
+    try {
+      endpoint = buildAiEndpoint(resolveAiCredential(this.getSettings(), { kind: 'main' }))
+    } catch {
+      return
+    }
+    try {
+      await new Promise<void>((resolve, reject) => {
+        const transport = endpoint.protocol === 'https:' ? https : http
+        const request = transport.request(
+          new URL(endpoint.origin),
+          { method: 'HEAD', agent: this.pool.agentFor(endpoint), timeout: WARMUP_TIMEOUT_MS },
+          (response) => {
+            response.resume()
+            response.on('end', resolve)
+            response.on('error', reject)
+          },
+        )
+        request.on('timeout', () => request.destroy(new Error('AI warmup timeout')))
+        request.on('error', reject)
+        request.end()
+      })
+    } catch {
+      // ignore
+    }
+  }
+
+  getPoolMetrics(): AiPoolMetrics {
+    return this.pool.snapshot()
+  }
+
   async startStream(sender: WebContents, payload: AIHttpStreamStartPayload): Promise<AIHttpStreamStartResult> {
     const streamId = String(payload.streamId ?? '').trim()
     if (!/^[a-zA-Z0-9_-]{8,160}$/.test(streamId)) throw new Error('Invalid AI stream ID')
@@ -156,14 +301,9 @@ export class AIHttpProxy {
     const timer = setTimeout(() => abortController.abort(new Error('AI HTTP timeout')), normalizeTimeoutMs(payload.timeoutMs))
     this.streams.set(streamId, { senderId: sender.id, abortController })
 
-    let response: Response
+    let response: PooledResponse
     try {
-      response = await fetch(endpoint, {
-        method: 'POST',
-        headers: buildAiHeaders(credential),
-        body,
-        signal: abortController.signal,
-      })
+      response = await requestViaPool(this.pool, endpoint, buildAiHeaders(credential), body, abortController.signal)
     } catch (error) {
       clearTimeout(timer)
       this.streams.delete(streamId)
@@ -175,14 +315,14 @@ export class AIHttpProxy {
       ok: response.ok,
       status: response.status,
       statusText: response.statusText,
-      contentType: response.headers.get('content-type') ?? '',
+      contentType: response.contentType,
     }
-    if (!response.ok || !response.body) {
+    if (!response.ok) {
       clearTimeout(timer)
       this.streams.delete(streamId)
       return {
         ...baseResult,
-        bodyText: response.body ? await response.text() : '',
+        bodyText: await response.text(),
       }
     }
 
@@ -197,11 +337,8 @@ export class AIHttpProxy {
 
     void (async () => {
       try {
-        const reader = response.body!.getReader()
-        for (;;) {
-          const { done, value } = await reader.read()
-          if (done) break
-          if (value) safeSend('ai:httpStreamChunk', { streamId, chunk: value })
+        for await (const chunk of response.stream) {
+          safeSend('ai:httpStreamChunk', { streamId, chunk })
         }
         safeSend('ai:httpStreamDone', { streamId })
       } catch (error) {
@@ -230,5 +367,6 @@ export class AIHttpProxy {
   close(): void {
     for (const active of this.streams.values()) active.abortController.abort(new Error('AI proxy closed'))
     this.streams.clear()
+    this.pool.destroy()
   }
 }
@@ -146,6 +146,15 @@ type SerializedScan = {
   }
 }
 
+// 每个页面按"代"缓存观察结果（扫描序列化、视口截图）：主框架导航或脚本/动作改写
+// 页面后代数递增并清空，代内短 TTL 内的重复 observe 直接命中缓存，省掉整棵 DOM 的
+// evaluate 和重新栅格化
+type PageObservationCache = {
+  generation: number
+  scans: Map<string, { capturedAt: number; scan: SerializedScan }>
+  screenshots: Map<string, { capturedAt: number; image: Buffer }>
+}
+
 const DEFAULT_PROFILE = 'default'
 const DEFAULT_TIMEOUT_MS = 45_000
 const DEFAULT_SCAN_MAX_CHARS = 8_000
@@ -153,6 +162,7 @@ const HARD_SCAN_MAX_CHARS = 20_000
 const DEFAULT_EXEC_MAX_CHARS = 8_000
 const ACTION_SETTLE_TIMEOUT_MS = 3_000
 const CONTEXT_IDLE_TIMEOUT_MS = 5 * 60_000
+const OBSERVATION_CACHE_TTL_MS = 5_000
 function clampText(value: unknown, maxChars: number): string {
   const text = typeof value === 'string' ? value : JSON.stringify(value, null, 2)
   const s = String(text ?? '').trim()
@@ -394,6 +404,8 @@ async function executePageScript(page: Page, script: string): Promise<unknown> {
 export class BrowserControlService {
   private readonly contexts = new Map<string, Promise<ManagedContext>>()
 
+  private readonly observationCaches = new WeakMap<Page, PageObservationCache>()
+
   constructor(private readonly userDataDir: string) {}
 
   async close(): Promise<void> {
@@ -474,7 +486,7 @@ export class BrowserControlService {
     const url = page.url()
     const selector = typeof options.selector === 'string' && options.selector.trim() ? options.selector.trim() : ''
     const textOnly = options.textOnly !== false
-    const serialized = await serializePage(page, selector, textOnly)
+    const { serialized, cached } = await this.serializePageCached(page, selector, textOnly)
     const content = textOnly ? serialized.text : serialized.html || serialized.text
     const result = {
       ok: true,
@@ -487,6 +499,7 @@ export class BrowserControlService {
         chars: content.length,
         truncated: content.trim().length > maxChars,
         textOnly,
+        cached,
       },
     }
     return JSON.stringify(result, null, 2)
@@ -501,6 +514,8 @@ export class BrowserControlService {
     const beforeUrl = page.url()
     const before = options.noMonitor === true ? null : await this.readPageBasics(page)
     const data = await executePageScript(page, options.script)
+    // 脚本可以在不导航的情况下改写 DOM，保守地让该页的观察缓存失效
+    this.invalidateObservations(page)
     const finalPage = await this.waitForActionOutcome(managed, page, beforePages, beforeUrl, options.timeoutMs)
     const after = options.noMonitor === true ? null : await this.readPageBasics(finalPage)
     const sourceAfter = options.noMonitor === true || finalPage === page ? undefined : await this.readPageBasics(page).catch(() => undefined)
@@ -614,6 +629,7 @@ export class BrowserControlService {
         const beforePages = new Set(this.openPages(managed))
         const beforeUrl = page.url()
         await this.runPlaywrightAction(page, action, timeoutMs, () => this.throwIfCanceled(options, deadlineMs))
+        if (this.actionMayMutatePage(action)) this.invalidateObservations(page)
         if (this.actionMayChangePage(action)) page = await this.waitForActionOutcome(managed, page, beforePages, beforeUrl, timeoutMs)
       }
 
@@ -839,6 +855,10 @@ export class BrowserControlService {
     return action.type === 'click' || action.type === 'press'
   }
 
+  private actionMayMutatePage(action: BrowserPlaywrightAction): boolean {
+    return action.type === 'click' || action.type === 'press' || action.type === 'fill'
+  }
+
   private async delay(ms: number): Promise<void> {
     await new Promise<void>((resolve) => setTimeout(resolve, ms))
   }
@@ -869,6 +889,9 @@ export class BrowserControlService {
     page.on('popup', (popup) => {
       this.registerPage(managed, popup, true)
     })
+    page.on('framenavigated', (frame) => {
+      if (frame === page.mainFrame()) this.invalidateObservations(page)
+    })
     page.once('close', () => {
       if (managed.activePage === page) {
         managed.activePage = this.openPages(managed)[0]
@@ -881,6 +904,38 @@ export class BrowserControlService {
     if (!page.isClosed()) managed.activePage = page
   }
 
+  private observationCacheFor(page: Page): PageObservationCache {
+    const existing = this.observationCaches.get(page)
+    if (existing) return existing
+    const cache: PageObservationCache = { generation: 0, scans: new Map(), screenshots: new Map() }
+    this.observationCaches.set(page, cache)
+    return cache
+  }
+
+  private invalidateObservations(page: Page): void {
+    const cache = this.observationCaches.get(page)
+    if (!cache) return
+    cache.generation += 1
+    cache.scans.clear()
+    cache.screenshots.clear()
+  }
+
+  private async serializePageCached(
+    page: Page,
+    selector: string,
+    textOnly: boolean,
+  ): Promise<{ serialized: SerializedScan; cached: boolean }> {
+    const cache = this.observationCacheFor(page)
+    const key = `${selector}\u0000${textOnly ? 'text' : 'html'}`
+    const entry = cache.scans.get(key)
+    if (entry && Date.now() - entry.capturedAt <= OBSERVATION_CACHE_TTL_MS) {
+      return { serialized: entry.scan, cached: true }
+    }
+    const serialized = await serializePage(page, selector, textOnly)
+    cache.scans.set(key, { capturedAt: Date.now(), scan: serialized })
+    return { serialized, cached: false }
+  }
+
   private async goto(page: Page, url: string, timeoutMs?: number): Promise<void> {
     if (!isHttpUrl(url)) throw new Error(`需要有效 URL（http/https），当前：${url || '(空)'}`)
     await page.goto(url, { waitUntil: 'domcontentloaded', timeout: normalizeTimeoutMs(timeoutMs) })
@@ -985,7 +1040,17 @@ export class BrowserControlService {
     if (!screenshot) return ''
 
     const fullPath = await resolveBrowserScreenshotPath(this.userDataDir, screenshot.path, taskId)
-    await page.screenshot({ path: fullPath, fullPage: screenshot.fullPage === true, timeout: timeoutMs })
+    const fullPage = screenshot.fullPage === true
+    const cache = this.observationCacheFor(page)
+    const cacheKey = fullPage ? 'fullPage' : 'viewport'
+    const entry = cache.screenshots.get(cacheKey)
+    if (entry && Date.now() - entry.capturedAt <= OBSERVATION_CACHE_TTL_MS) {
+      // 同代页面的重复截图直接复用上次的位图，只按请求路径重新落盘
+      await fs.writeFile(fullPath, entry.image)
+      return fullPath
+    }
+    const image = await page.screenshot({ path: fullPath, fullPage, timeout: timeoutMs })
+    cache.screenshots.set(cacheKey, { capturedAt: Date.now(), image })
     return fullPath
   }
 
@@ -3,6 +3,7 @@ import fs from 'node:fs'
 import { createRequire } from 'node:module'
 import { randomUUID } from 'node:crypto'
 import { app } from 'electron'
+import { applyChatJournalEntries, ChatStoreJournal } from './chatStoreJournal'
 import type { ChatMessageRecord, ChatSession, ChatSessionSummary } from './types'
 
 type SessionNameMode = 'auto' | 'manual'
@@ -13,9 +14,12 @@ const MAX_SESSIONS = 30
 
 // 旧版使用 electron-store（每次写入全量序列化整个聊天历史到 JSON，阻塞主进程且随
 // 数据量线性恶化）。现迁移到 better-sqlite3：追加一条消息只是一次 INSERT。
-// 对外 API 签名与旧版完全一致，调用方零改动。
+// 消息级写操作（追加/更新/删除）进一步走写回日志：条目进内存日志即返回，由
+// chatStoreWorker 工作线程按批次在单个事务内落盘，读侧叠加未落盘条目保证
+// read-your-writes。对外 API 签名与旧版完全一致，调用方零改动。
 
 let dbHandle: DatabaseHandle | null = null
+let journal: ChatStoreJournal | null = null
 
 type SessionRow = {
   id: string
@@ -86,10 +90,23 @@ function db(): DatabaseHandle {
   `)
 
   dbHandle = handle
+  journal = new ChatStoreJournal(dbPath, {
+    applyDirect: (entries) => applyChatJournalEntries(handle, entries),
+  })
   migrateFromLegacyJson(handle, userDataDir)
   return handle
 }
 
+function journalRef(): ChatStoreJournal {
+  db()
+  return journal as ChatStoreJournal
+}
+
+// 结构性操作（建/删/清会话、整表重写）前先把日志落盘，保证后续同步 SQL 与日志顺序一致
+function drainJournal(): void {
+  journalRef().drain()
+}
+
 function now(): number {
   return Date.now()
 }
@@ -148,11 +165,49 @@ function rowToMessage(r: MessageRow): ChatMessageRecord {
   }
 }
 
-function getSessionMessages(sessionId: string): ChatMessageRecord[] {
+type SeqMessageRow = MessageRow & { seq: number }
+
+// 某会话的消息行，按追加顺序重放未落盘的日志条目，读到的状态与全部落盘后一致
+function mergedMessageRows(sessionId: string): SeqMessageRow[] {
   const rows = db()
-    .prepare('SELECT id, role, content, created_at, updated_at, extra FROM chat_message WHERE session_id = ? ORDER BY seq ASC')
-    .all(sessionId) as MessageRow[]
-  return rows.map(rowToMessage)
+    .prepare('SELECT id, seq, role, content, created_at, updated_at, extra FROM chat_message WHERE session_id = ? ORDER BY seq ASC')
+    .all(sessionId) as SeqMessageRow[]
+  const pending = journalRef().pendingFor(sessionId)
+  if (pending.length === 0) return rows
+
+  const byId = new Map<string, SeqMessageRow>(rows.map((r) => [r.id, r]))
+  for (const entry of pending) {
+    if (entry.op === 'upsertMessage') {
+      byId.set(entry.messageId, {
+        id: entry.messageId,
+        seq: entry.seq,
+        role: entry.role,
+        content: entry.content,
+        created_at: entry.createdAt,
+        updated_at: entry.updatedAt,
+        extra: entry.extra,
+      })
+    } else if (entry.op === 'updateContent') {
+      const current = byId.get(entry.messageId)
+      if (current) byId.set(entry.messageId, { ...current, content: entry.content, updated_at: entry.ts })
+    } else if (entry.op === 'deleteMessage') {
+      byId.delete(entry.messageId)
+    }
+  }
+  return [...byId.values()].sort((a, b) => a.seq - b.seq)
+}
+
+function getSessionMessages(sessionId: string): ChatMessageRecord[] {
+  return mergedMessageRows(sessionId).map(rowToMessage)
+}
+
+// 会话 updated_at 的日志叠加（touchSession 尚未落盘时读侧也要看到最新时间戳）
+function pendingTouchTs(sessionId: string): number {
+  let ts = 0
+  for (const entry of journalRef().pendingFor(sessionId)) {
+    if (entry.op === 'touchSession' && entry.ts > ts) ts = entry.ts
+  }
+  return ts
 }
 
 function rowToSession(r: SessionRow): ChatSession {
@@ -166,7 +221,7 @@ function rowToSession(r: SessionRow): ChatSession {
     autoExtractLastWriteCount: r.auto_extract_last_write_count,
     autoExtractLastError: r.auto_extract_last_error,
     createdAt: r.created_at,
-    updatedAt: r.updated_at,
+    updatedAt: Math.max(r.updated_at, pendingTouchTs(r.id)),
     messages: getSessionMessages(r.id),
   }
 }
@@ -202,11 +257,34 @@ function insertMessageRow(sessionId: string, seq: number, m: ChatMessageRecord):
     .run(sessionId, m.id, seq, m.role, m.content ?? '', m.createdAt ?? now(), m.updatedAt ?? null, messageExtra(m))
 }
 
+// 消息写热路径统一从这里进日志（extra 序列化在主进程完成，工作线程只重放行镜像）
+function enqueueMessageUpsert(sessionId: string, seq: number, m: ChatMessageRecord): void {
+  journalRef().append({
+    op: 'upsertMessage',
+    sessionId,
+    messageId: m.id,
+    seq,
+    role: m.role,
+    content: m.content ?? '',
+    createdAt: m.createdAt ?? now(),
+    updatedAt: m.updatedAt ?? null,
+    extra: messageExtra(m),
+  })
+}
+
+function enqueueTouchSession(sessionId: string, ts?: number): void {
+  journalRef().append({ op: 'touchSession', sessionId, ts: ts ?? now() })
+}
+
 function nextSeq(sessionId: string): number {
   const row = db().prepare('SELECT COALESCE(MAX(seq), -1) AS maxSeq FROM chat_message WHERE session_id = ?').get(sessionId) as {
     maxSeq: number
   }
-  return row.maxSeq + 1
+  let maxSeq = row.maxSeq
+  for (const entry of journalRef().pendingFor(sessionId)) {
+    if (entry.op === 'upsertMessage' && entry.seq > maxSeq) maxSeq = entry.seq
+  }
+  return maxSeq + 1
 }
 
 function touchSession(sessionId: string, ts?: number): void {
@@ -399,18 +477,28 @@ function toSummary(session: ChatSession): ChatSessionSummary {
 }
 
 function summaryRowOf(r: SessionRow): ChatSessionSummary {
-  const countRow = db().prepare('SELECT COUNT(*) AS n FROM chat_message WHERE session_id = ?').get(r.id) as { n: number }
-  const lastRow = db()
-    .prepare('SELECT content FROM chat_message WHERE session_id = ? ORDER BY seq DESC LIMIT 1')
-    .get(r.id) as { content: string } | undefined
-  const preview = lastRow?.content?.trim()
+  let messageCount: number
+  let preview: string | undefined
+  if (journalRef().hasPending(r.id)) {
+    // 有未落盘条目时走重放视图，计数/预览与落盘后一致
+    const merged = mergedMessageRows(r.id)
+    messageCount = merged.length
+    preview = merged[merged.length - 1]?.content?.trim()
+  } else {
+    const countRow = db().prepare('SELECT COUNT(*) AS n FROM chat_message WHERE session_id = ?').get(r.id) as { n: number }
+    const lastRow = db()
+      .prepare('SELECT content FROM chat_message WHERE session_id = ? ORDER BY seq DESC LIMIT 1')
+      .get(r.id) as { content: string } | undefined
+    messageCount = countRow.n
+    preview = lastRow?.content?.trim()
+  }
   return {
     id: r.id,
     name: r.name,
     personaId: r.persona_id,
     createdAt: r.created_at,
-    updatedAt: r.updated_at,
-    messageCount: countRow.n,
+    updatedAt: Math.max(r.updated_at, pendingTouchTs(r.id)),
+    messageCount,
     autoExtractCursor: r.auto_extract_cursor,
     autoExtractLastRunAt: r.auto_extract_last_run_at,
     autoExtractLastWriteCount: r.auto_extract_last_write_count,
@@ -422,7 +510,9 @@ function summaryRowOf(r: SessionRow): ChatSessionSummary {
 export function listChatSessions(): { sessions: ChatSessionSummary[]; currentSessionId: string } {
   const currentSessionId = ensureConsistent()
   const rows = db().prepare('SELECT * FROM chat_session ORDER BY updated_at DESC').all() as SessionRow[]
-  return { sessions: rows.map(summaryRowOf), currentSessionId }
+  // 未落盘的 touchSession 可能改变排序，按叠加后的 updatedAt 重排
+  const sessions = rows.map(summaryRowOf).sort((a, b) => b.updatedAt - a.updatedAt)
+  return { sessions, currentSessionId }
 }
 
 export function getChatSession(sessionId?: string): ChatSession {
@@ -440,6 +530,7 @@ export function setCurrentChatSession(sessionId: string): { currentSessionId: st
 
 export function createChatSession(name?: string, personaId?: string): ChatSession {
   ensureConsistent()
+  drainJournal()
   const pid = personaId?.trim() || 'default'
   const tx = db().transaction(() => {
     const id = createSessionInDb(name, pid)
@@ -452,6 +543,7 @@ export function createChatSession(name?: string, personaId?: string): ChatSessio
 
 export function renameChatSession(sessionId: string, name: string): ChatSessionSummary {
   ensureConsistent()
+  drainJournal()
   const cleaned = name.trim()
   if (cleaned && getSessionRow(sessionId)) {
     db().prepare("UPDATE chat_session SET name = ?, name_mode = 'manual', updated_at = ? WHERE id = ?").run(cleaned, now(), sessionId)
@@ -462,6 +554,7 @@ export function renameChatSession(sessionId: string, name: string): ChatSessionS
 
 export function deleteChatSession(sessionId: string): { sessions: ChatSessionSummary[]; currentSessionId: string } {
   ensureConsistent()
+  drainJournal()
   const tx = db().transaction(() => {
     const removed = getSessionRow(sessionId)
     const fallbackPersonaId = removed?.persona_id?.trim() || 'default'
@@ -477,6 +570,7 @@ export function deleteChatSession(sessionId: string): { sessions: ChatSessionSum
 
 export function clearChatSession(sessionId: string): ChatSession {
   ensureConsistent()
+  drainJournal()
   const tx = db().transaction(() => {
     const row = getSessionRow(sessionId)
     if (!row) return
@@ -506,6 +600,7 @@ export function clearChatSession(sessionId: string): ChatSession {
 
 export function setChatMessages(sessionId: string, messages: ChatMessageRecord[]): ChatSession {
   ensureConsistent()
+  drainJournal()
   const tx = db().transaction(() => {
     if (!getSessionRow(sessionId)) return
     db().prepare('DELETE FROM chat_message WHERE session_id = ?').run(sessionId)
@@ -518,28 +613,26 @@ export function setChatMessages(sessionId: string, messages: ChatMessageRecord[]
 
 export function addChatMessage(sessionId: string, message: ChatMessageRecord): ChatSession {
   ensureConsistent()
-  const tx = db().transaction(() => {
-    const row = getSessionRow(sessionId)
-    if (!row) return
+  const row = getSessionRow(sessionId)
+  if (row) {
     const seq = nextSeq(sessionId)
-    insertMessageRow(sessionId, seq, message)
+    enqueueMessageUpsert(sessionId, seq, message)
 
-    // 首条用户消息触发自动命名（与旧版语义一致）
+    // 首条用户消息触发自动命名（与旧版语义一致）；命名是一次性低频写，直接落库
     if (seq === 0 && row.name_mode !== 'manual' && message.role === 'user') {
       const auto = autoSessionNameFromFirstMessage(message.content)
       if (auto) db().prepare('UPDATE chat_session SET name = ? WHERE id = ?').run(auto, sessionId)
     }
-    touchSession(sessionId)
-  })
-  tx()
+    enqueueTouchSession(sessionId)
+  }
   return getChatSession(sessionId)
 }
 
 export function updateChatMessage(sessionId: string, messageId: string, content: string): ChatSession {
   ensureConsistent()
   const ts = now()
-  db().prepare('UPDATE chat_message SET content = ?, updated_at = ? WHERE session_id = ? AND id = ?').run(content, ts, sessionId, messageId)
-  touchSession(sessionId, ts)
+  journalRef().append({ op: 'updateContent', sessionId, messageId, content, ts })
+  enqueueTouchSession(sessionId, ts)
   return getChatSession(sessionId)
 }
 
@@ -549,39 +642,33 @@ export function updateChatMessageRecord(sessionId: string, messageId: string, pa
 
   const p = patch as Partial<ChatMessageRecord> & Record<string, unknown>
 
-  const tx = db().transaction(() => {
-    const row = db()
-      .prepare('SELECT id, role, content, created_at, updated_at, extra FROM chat_message WHERE session_id = ? AND id = ?')
-      .get(sessionId, messageId) as MessageRow | undefined
-    if (!row) return
+  // 当前行可能还在日志里未落盘，从重放视图读；写回整行镜像（同 seq 的 upsert）
+  const row = mergedMessageRows(sessionId).find((r) => r.id === messageId)
+  if (!row) return getChatSession(sessionId)
 
-    const current = rowToMessage(row)
-    const next: ChatMessageRecord = { ...current }
+  const current = rowToMessage(row)
+  const next: ChatMessageRecord = { ...current }
 
-    if ('content' in p && typeof p.content === 'string') next.content = p.content
-    if ('attachments' in p) {
-      next.attachments = Array.isArray(p.attachments) ? (p.attachments as ChatMessageRecord['attachments']) : undefined
-    }
-    if ('image' in p) next.image = typeof p.image === 'string' ? p.image : undefined
-    if ('imagePath' in p) next.imagePath = typeof p.imagePath === 'string' ? p.imagePath : undefined
-    if ('videoPath' in p) next.videoPath = typeof p.videoPath === 'string' ? p.videoPath : undefined
-    if ('taskId' in p) next.taskId = typeof p.taskId === 'string' ? p.taskId : undefined
-    if ('blocks' in p) next.blocks = Array.isArray(p.blocks) ? (p.blocks as ChatMessageRecord['blocks']) : undefined
-    next.updatedAt = now()
-
-    db()
-      .prepare('UPDATE chat_message SET content = ?, updated_at = ?, extra = ? WHERE session_id = ? AND id = ?')
-      .run(next.content ?? '', next.updatedAt, messageExtra(next), sessionId, messageId)
-    touchSession(sessionId, next.updatedAt)
-  })
-  tx()
+  if ('content' in p && typeof p.content === 'string') next.content = p.content
+  if ('attachments' in p) {
+    next.attachments = Array.isArray(p.attachments) ? (p.attachments as ChatMessageRecord['attachments']) : undefined
+  }
+  if ('image' in p) next.image = typeof p.image === 'string' ? p.image : undefined
+  if ('imagePath' in p) next.imagePath = typeof p.imagePath === 'string' ? p.imagePath : undefined
+  if ('videoPath' in p) next.videoPath = typeof p.videoPath === 'string' ? p.videoPath : undefined
+  if ('taskId' in p) next.taskId = typeof p.taskId === 'string' ? p.taskId : undefined
+  if ('blocks' in p) next.blocks = Array.isArray(p.blocks) ? (p.blocks as ChatMessageRecord['blocks']) : undefined
+  next.updatedAt = now()
+
+  enqueueMessageUpsert(sessionId, row.seq, next)
+  enqueueTouchSession(sessionId, next.updatedAt)
   return getChatSession(sessionId)
 }
 
 export function deleteChatMessage(sessionId: string, messageId: string): ChatSession {
   ensureConsistent()
-  db().prepare('DELETE FROM chat_message WHERE session_id = ? AND id = ?').run(sessionId, messageId)
-  touchSession(sessionId)
+  journalRef().append({ op: 'deleteMessage', sessionId, messageId })
+  enqueueTouchSession(sessionId)
   return getChatSession(sessionId)
 }
 
@@ -635,3 +722,13 @@ export function setChatSessionAutoExtractMeta(sessionId: string, patch: unknown)
     .run(...args, sessionId)
   return getChatSession(sessionId)
 }
+
+// before-quit：同步把内存日志落盘（工作线程批量事务，超时则主线程兜底直写）
+export function flushChatStore(): void {
+  journal?.drain()
+}
+
+// will-quit：落盘剩余日志并回收工作线程（此后再有写入会惰性重建线程）
+export function closeChatStore(): void {
+  journal?.close()
+}
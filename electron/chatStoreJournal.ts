@@ -0,0 +1,269 @@
+import path from 'node:path'
+import { Worker } from 'node:worker_threads'
+
+// 聊天写回日志：消息级写操作先进入内存日志，由 chatStoreWorker 工作线程按批次在单个
+// 事务内落盘，主进程热路径（流式增量落库）不再执行同步 SQLite 写。
+// 读侧把未落盘的日志条目叠加在 SQL 结果上（read-your-writes），结构性操作与退出前
+// 通过 drain() 同步屏障等待工作线程提交（SharedArrayBuffer + Atomics），超时或线程
+// 异常时回退为主线程直写，日志内容不会丢失。
+
+export type ChatJournalEntry =
+  | {
+      op: 'upsertMessage'
+      sessionId: string
+      messageId: string
+      seq: number
+      role: string
+      content: string
+      createdAt: number
+      updatedAt: number | null
+      extra: string | null
+    }
+  | { op: 'updateContent'; sessionId: string; messageId: string; content: string; ts: number }
+  | { op: 'deleteMessage'; sessionId: string; messageId: string }
+  | { op: 'touchSession'; sessionId: string; ts: number }
+
+export type ChatStoreWorkerRequest = { type: 'flush'; batchId: number; entries: ChatJournalEntry[] }
+
+export type ChatStoreWorkerResponse =
+  | { type: 'flushed'; batchId: number }
+  | { type: 'error'; batchId: number; error: string }
+
+// 主进程兜底直写与工作线程共用同一套落盘逻辑，保证两条路径语义一致
+export type ChatJournalDatabase = {
+  prepare: (sql: string) => { run: (...args: unknown[]) => unknown }
+  transaction: (fn: () => void) => () => void
+}
+
+export function applyChatJournalEntries(handle: ChatJournalDatabase, entries: ChatJournalEntry[]): void {
+  const tx = handle.transaction(() => {
+    for (const entry of entries) {
+      if (entry.op === 'upsertMessage') {
+        handle
+          .prepare(
+            `INSERT OR REPLACE INTO chat_message (session_id, id, seq, role, content, created_at, updated_at, extra)
+             VALUES (?, ?, ?, ?, ?, ?, ?, ?)`,
+          )
+          .run(
+            entry.sessionId,
+            entry.messageId,
+            entry.seq,
+            entry.role,
+            entry.content,
+            entry.createdAt,
+            entry.updatedAt,
+            entry.extra,
+          )
+      } else if (entry.op === 'updateContent') {
+        handle
+          .prepare('UPDATE chat_message SET content = ?, updated_at = ? WHERE session_id = ? AND id = ?')
+          .run(entry.content, entry.ts, entry.sessionId, entry.messageId)
+      } else if (entry.op === 'deleteMessage') {
+        handle.prepare('DELETE FROM chat_message WHERE session_id = ? AND id = ?').run(entry.sessionId, entry.messageId)
+      } else {
+        handle.prepare('UPDATE chat_session SET updated_at = ? WHERE id = ?').run(entry.ts, entry.sessionId)
+      }
+    }
+  })
+  tx()
+}
+
+export type ChatStoreWorker = {
+  unref: () => void
+  on: {
+    (event: 'message', listener: (message: ChatStoreWorkerResponse) => void): ChatStoreWorker
+    (event: 'error', listener: (error: Error) => void): ChatStoreWorker
+    (event: 'exit', listener: (code: number) => void): ChatStoreWorker
+  }
+  postMessage: (message: ChatStoreWorkerRequest) => void
+  terminate: () => Promise<number>
+}
+
+export type ChatStoreWorkerFactory = (
+  filename: string,
+  options: { workerData: { dbPath: string; sharedState: SharedArrayBuffer } },
+) => ChatStoreWorker
+
+export type ChatStoreJournalOptions = {
+  // 日志条目先直写数据库的回退通道（工作线程不可用/未按时提交时调用）
+  applyDirect: (entries: ChatJournalEntry[]) => void
+  flushIntervalMs?: number
+  drainTimeoutMs?: number
+  workerPath?: string
+  workerFactory?: ChatStoreWorkerFactory
+}
+
+type UnackedEntry = { batch: number | null; entry: ChatJournalEntry }
+
+export class ChatStoreJournal {
+  private readonly dbPath: string
+  private readonly applyDirect: (entries: ChatJournalEntry[]) => void
+  private readonly flushIntervalMs: number
+  private readonly drainTimeoutMs: number
+  private readonly workerPath: string
+  private readonly workerFactory: ChatStoreWorkerFactory
+  // [0] = 工作线程已提交的最大 batchId，drain() 用 Atomics.wait 同步等待
+  private readonly sharedState = new SharedArrayBuffer(4)
+  private readonly committed = new Int32Array(this.sharedState)
+  private worker: ChatStoreWorker | null = null
+  private unacked: UnackedEntry[] = []
+  private lastBatchId = 0
+  private flushTimer: NodeJS.Timeout | null = null
+  // 工作线程创建失败后进入直写模式，append 直接落主线程连接
+  private directMode = false
+
+  constructor(dbPath: string, options: ChatStoreJournalOptions) {
+    this.dbPath = dbPath
+    this.applyDirect = options.applyDirect
+    this.flushIntervalMs = Math.max(10, Math.floor(options.flushIntervalMs ?? 200))
+    this.drainTimeoutMs = Math.max(1, Math.floor(options.drainTimeoutMs ?? 2000))
+    this.workerPath = options.workerPath ?? path.join(__dirname, 'chatStoreWorker.js')
+    this.workerFactory =
+      options.workerFactory ??
+      ((filename, workerOptions) => new Worker(filename, workerOptions) as unknown as ChatStoreWorker)
+  }
+
+  append(entry: ChatJournalEntry): void {
+    if (this.directMode) {
+      this.applyDirect([entry])
+      return
+    }
+    this.unacked.push({ batch: null, entry })
+    if (this.flushTimer === null) {
+      this.flushTimer = setTimeout(() => {
+        this.flushTimer = null
+        this.flush()
+      }, this.flushIntervalMs)
+      this.flushTimer.unref?.()
+    }
+  }
+
+  // 读侧叠加层：按追加顺序返回某会话尚未确认落盘的日志条目
+  pendingFor(sessionId: string): ChatJournalEntry[] {
+    if (this.unacked.length === 0) return []
+    const pending: ChatJournalEntry[] = []
+    for (const item of this.unacked) {
+      if (item.entry.sessionId === sessionId) pending.push(item.entry)
+    }
+    return pending
+  }
+
+  hasPending(sessionId: string): boolean {
+    return this.unacked.some((item) => item.entry.sessionId === sessionId)
+  }
+
+  // 同步屏障：结构性操作（建/删/清会话、整表重写）和 before-quit 前调用，
+  // 返回时日志已全部落盘（工作线程提交或主线程兜底直写）
+  drain(): void {
+    this.reap()
+    if (this.unacked.length === 0) return
+    this.flush()
+    const target = this.lastBatchId
+    const deadline = Date.now() + this.drainTimeoutMs
+    while (this.worker && Atomics.load(this.committed, 0) < target) {
+      const remain = deadline - Date.now()
+      if (remain <= 0) break
+      Atomics.wait(this.committed, 0, Atomics.load(this.committed, 0), Math.min(remain, 50))
+    }
+    this.reap()
+    if (this.unacked.length > 0) this.fallbackDirect()
+  }
+
+  close(): void {
+    if (this.flushTimer !== null) {
+      clearTimeout(this.flushTimer)
+      this.flushTimer = null
+    }
+    this.drain()
+    const worker = this.worker
+    this.worker = null
+    if (worker) void worker.terminate().catch(() => undefined)
+  }
+
+  private flush(): void {
+    if (this.directMode) return
+    const queued = this.unacked.filter((item) => item.batch === null)
+    if (queued.length === 0) return
+    const worker = this.getWorker()
+    if (!worker) return
+    const batchId = ++this.lastBatchId
+    for (const item of queued) item.batch = batchId
+    try {
+      worker.postMessage({ type: 'flush', batchId, entries: queued.map((item) => item.entry) })
+    } catch (error) {
+      console.error('[ChatStore] journal flush postMessage failed:', error)
+      this.fallbackDirect()
+    }
+  }
+
+  // 丢弃已被工作线程提交的条目（提交水位来自共享内存，无需等消息回执）
+  private reap(committedBatchId: number = Atomics.load(this.committed, 0)): void {
+    if (this.unacked.length === 0) return
+    this.unacked = this.unacked.filter((item) => item.batch === null || item.batch > committedBatchId)
+  }
+
+  // 工作线程不可用：剩余日志在主线程直写。条目均为幂等写（INSERT OR REPLACE /
+  // UPDATE / DELETE）且按原顺序重放，与可能已提交的批次重叠也不会破坏最终状态。
+  private fallbackDirect(): void {
+    const worker = this.worker
+    this.worker = null
+    if (worker) void worker.terminate().catch(() => undefined)
+    const entries = this.unacked.map((item) => item.entry)
+    this.unacked = []
+    try {
+      this.applyDirect(entries)
+    } catch (error) {
+      console.error('[ChatStore] journal direct write failed:', error)
+    }
+  }
+
+  private getWorker(): ChatStoreWorker | null {
+    if (this.worker) return this.worker
+    let worker: ChatStoreWorker
+    try {
+      worker = this.workerFactory(this.workerPath, {
+        workerData: { dbPath: this.dbPath, sharedState: this.sharedState },
+      })
+    } catch (error) {
+      console.error('[ChatStore] journal worker unavailable, falling back to direct writes:', error)
+      this.directMode = true
+      this.fallbackDirect()
+      return null
+    }
+    worker.unref()
+    worker.on('message', (message) => {
+      if (this.worker !== worker) return
+      if (message.type === 'flushed') {
+        this.reap(message.batchId)
+        return
+      }
+      // 批次事务失败：该批次条目改走主线程直写，工作线程重建
+      console.error('[ChatStore] journal worker flush failed:', message.error)
+      const failed = this.unacked.filter((item) => item.batch !== null && item.batch <= message.batchId)
+      this.unacked = this.unacked.filter((item) => item.batch === null || item.batch > message.batchId)
+      this.worker = null
+      void worker.terminate().catch(() => undefined)
+      try {
+        this.applyDirect(failed.map((item) => item.entry))
+      } catch (error) {
+        console.error('[ChatStore] journal direct write failed:', error)
+      }
+    })
+    worker.on('error', (error) => {
+      if (this.worker === worker) this.handleWorkerLoss(error)
+    })
+    worker.on('exit', (code) => {
+      if (this.worker === worker) this.handleWorkerLoss(new Error(`chat store worker exited (code ${code})`))
+    })
+    this.worker = worker
+    return worker
+  }
+
+  // 工作线程意外退出：已提交的按水位丢弃，已发送未提交的退回队列等待下次 flush 重放
+  private handleWorkerLoss(reason: Error): void {
+    console.error('[ChatStore] journal worker lost:', reason.message)
+    this.worker = null
+    this.reap()
+    for (const item of this.unacked) item.batch = null
+  }
+}
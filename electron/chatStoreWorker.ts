@@ -0,0 +1,54 @@
+// 聊天持久化工作线程：主进程把消息级写操作累积进内存日志（见 chatStoreJournal.ts），
+// 这里按批次在单个事务内落盘，快速流式输出期间主进程不再被同步 SQLite 写阻塞。
+// 每批提交后把 batchId 写进共享内存并 notify，供主进程 drain() 同步等待。
+import { createRequire } from 'node:module'
+import { parentPort, workerData } from 'node:worker_threads'
+import {
+  applyChatJournalEntries,
+  type ChatStoreWorkerRequest,
+  type ChatStoreWorkerResponse,
+} from './chatStoreJournal'
+
+type DatabaseHandle = import('better-sqlite3').Database
+
+const data = workerData as { dbPath?: string; sharedState?: SharedArrayBuffer } | undefined
+const dbPath = String(data?.dbPath ?? '')
+const committed = data?.sharedState ? new Int32Array(data.sharedState) : null
+
+let db: DatabaseHandle | null = null
+
+function openDb(): DatabaseHandle {
+  if (db) return db
+  const require = createRequire(import.meta.url)
+  const mod = require('better-sqlite3') as unknown as { default?: unknown }
+  const Database = (mod.default ?? mod) as unknown as { new (file: string): DatabaseHandle }
+  // 与主进程连接同库并存（WAL）；busy_timeout 兜底 checkpoint/主线程兜底直写竞争
+  db = new Database(dbPath)
+  db.pragma('journal_mode = WAL')
+  db.pragma('synchronous = NORMAL')
+  db.pragma('foreign_keys = ON')
+  db.pragma('busy_timeout = 3000')
+  return db
+}
+
+function handleFlush(request: ChatStoreWorkerRequest): void {
+  applyChatJournalEntries(openDb(), request.entries)
+  if (committed) {
+    Atomics.store(committed, 0, request.batchId)
+    Atomics.notify(committed, 0)
+  }
+  parentPort?.postMessage({ type: 'flushed', batchId: request.batchId } satisfies ChatStoreWorkerResponse)
+}
+
+parentPort?.on('message', (message: ChatStoreWorkerRequest) => {
+  if (!message || message.type !== 'flush') return
+  try {
+    handleFlush(message)
+  } catch (error) {
+    parentPort?.postMessage({
+      type: 'error',
+      batchId: message.batchId,
+      error: error instanceof Error ? error.message : String(error),
+    } satisfies ChatStoreWorkerResponse)
+  }
+})
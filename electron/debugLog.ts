@@ -13,20 +13,26 @@ let enabled = false
 let baseDir = ''
 let logFilePath = ''
 let initialized = false
+let crashFlushHookInstalled = false
 const lastWriteAtByScope = new Map<string, number>()
 const lastWriteAtByEvent = new Map<string, number>()
-const pendingLines: string[] = []
-let pendingBytes = 0
 let flushTimer: NodeJS.Timeout | null = null
 let flushing = false
 
 const DEBUG_LOG_FLUSH_INTERVAL_MS = 50
-const DEBUG_LOG_MAX_QUEUE_LINES = 2000
-const DEBUG_LOG_MAX_QUEUE_BYTES = 2 * 1024 * 1024
+const DEBUG_LOG_RING_CAPACITY = 2048
 const DEBUG_LOG_FILE_MAX_BYTES = 20 * 1024 * 1024
 const DEBUG_LOG_ROTATE_KEEP_FILES = 3
 const REDACTED_LOG_VALUE = '[REDACTED]'
 
+// 环形队列：appendDebugLog 只入队条目引用（不做脱敏/序列化），这两步都推迟到
+// 后台刷写里执行，让工具执行、MCP 流量、任务循环等热路径的调用开销接近常数。
+// 队列满时覆盖最旧条目（drop-oldest），丢弃数量在下次刷写时记一条标记日志。
+const entryRing: (DebugLogEntry | null)[] = new Array(DEBUG_LOG_RING_CAPACITY).fill(null)
+let ringHead = 0
+let ringCount = 0
+let ringDroppedEntries = 0
+
 function now(): number {
   return Date.now()
 }
@@ -77,6 +83,17 @@ function ensureInitialized(): void {
   if (!enabled) return
   ensureDir(baseDir)
   void cleanupRotatedLogFiles()
+  if (!crashFlushHookInstalled) {
+    crashFlushHookInstalled = true
+    // 'exit' 在正常退出和未捕获异常导致的崩溃退出前都会触发，此时只能做同步 IO
+    process.once('exit', () => {
+      try {
+        flushDebugLogSync()
+      } catch {
+        // ignore
+      }
+    })
+  }
 }
 
 function isSensitiveLogKey(key: string, value: unknown): boolean {
@@ -163,8 +180,10 @@ export function clearDebugLog(): void {
   ensureInitialized()
   if (!enabled) return
   try {
-    pendingLines.length = 0
-    pendingBytes = 0
+    entryRing.fill(null)
+    ringHead = 0
+    ringCount = 0
+    ringDroppedEntries = 0
     if (flushTimer) {
       clearTimeout(flushTimer)
       flushTimer = null
@@ -280,22 +299,63 @@ function getEventThrottleMs(scope: string, event: string, data?: unknown): numbe
   return 0
 }
 
+function enqueueEntry(entry: DebugLogEntry): void {
+  if (ringCount === DEBUG_LOG_RING_CAPACITY) {
+    entryRing[ringHead] = null
+    ringHead = (ringHead + 1) % DEBUG_LOG_RING_CAPACITY
+    ringCount -= 1
+    ringDroppedEntries += 1
+  }
+  entryRing[(ringHead + ringCount) % DEBUG_LOG_RING_CAPACITY] = entry
+  ringCount += 1
+}
+
+// 把环形队列一次性排空成待序列化条目；丢弃计数折算成一条标记日志放在最前
+function drainRing(): DebugLogEntry[] {
+  const drained: DebugLogEntry[] = []
+  if (ringDroppedEntries > 0) {
+    drained.push({
+      ts: now(),
+      pid: process.pid,
+      scope: 'debugLog',
+      event: 'entries.dropped',
+      data: { count: ringDroppedEntries },
+    })
+    ringDroppedEntries = 0
+  }
+  while (ringCount > 0) {
+    const entry = entryRing[ringHead]
+    entryRing[ringHead] = null
+    ringHead = (ringHead + 1) % DEBUG_LOG_RING_CAPACITY
+    ringCount -= 1
+    if (entry) drained.push(entry)
+  }
+  return drained
+}
+
+function serializeEntries(entries: DebugLogEntry[]): string {
+  let chunk = ''
+  for (const entry of entries) {
+    chunk += safeJsonStringify({ ...entry, data: redactSensitiveLogData(entry.data) }) + '\n'
+  }
+  return chunk
+}
+
 function scheduleFlush(): void {
-  if (flushTimer || flushing || !enabled || pendingLines.length === 0 || !logFilePath) return
+  if (flushTimer || flushing || !enabled || ringCount === 0 || !logFilePath) return
   flushTimer = setTimeout(() => {
     flushTimer = null
-    void flushPendingLines()
+    void flushPendingEntries()
   }, DEBUG_LOG_FLUSH_INTERVAL_MS)
   ;(flushTimer as unknown as { unref?: () => void }).unref?.()
 }
 
-async function flushPendingLines(): Promise<void> {
-  if (flushing || !enabled || !logFilePath || pendingLines.length === 0) return
+async function flushPendingEntries(): Promise<void> {
+  if (flushing || !enabled || !logFilePath) return
+  if (ringCount === 0 && ringDroppedEntries === 0) return
   flushing = true
 
-  const chunk = pendingLines.join('')
-  pendingLines.length = 0
-  pendingBytes = 0
+  const chunk = serializeEntries(drainRing())
 
   try {
     ensureDir(path.dirname(logFilePath))
@@ -305,7 +365,26 @@ async function flushPendingLines(): Promise<void> {
     // ignore
   } finally {
     flushing = false
-    if (pendingLines.length > 0) scheduleFlush()
+    if (ringCount > 0) scheduleFlush()
+  }
+}
+
+/** 崩溃/退出路径的兜底：同步把环形队列里剩余的条目写进日志文件（跳过轮转）。 */
+export function flushDebugLogSync(): void {
+  if (!enabled || !logFilePath) return
+  if (ringCount === 0 && ringDroppedEntries === 0) return
+  if (flushTimer) {
+    clearTimeout(flushTimer)
+    flushTimer = null
+  }
+
+  const chunk = serializeEntries(drainRing())
+
+  try {
+    ensureDir(path.dirname(logFilePath))
+    fs.appendFileSync(logFilePath, chunk, 'utf-8')
+  } catch {
+    // ignore
   }
 }
 
@@ -332,30 +411,14 @@ export function appendDebugLog(scope: string, event: string, data?: unknown): vo
     lastWriteAtByEvent.set(eventThrottleKey, ts)
   }
 
-  const entry: DebugLogEntry = {
+  // 只入队引用：脱敏和 JSON 序列化在后台刷写时才做。调用方传入的对象若在入队后
+  // 被原地修改，落盘的是刷写时刻的快照——现有调用方都传字面量/一次性对象，可接受。
+  enqueueEntry({
     ts,
     pid: process.pid,
     scope: scopeKey,
     event: String(event ?? '').trim() || 'unknown',
-    data: redactSensitiveLogData(data),
-  }
-
-  try {
-    const line = safeJsonStringify(entry) + '\n'
-    const lineBytes = Buffer.byteLength(line, 'utf8')
-
-    if (pendingLines.length >= DEBUG_LOG_MAX_QUEUE_LINES || pendingBytes + lineBytes > DEBUG_LOG_MAX_QUEUE_BYTES) {
-      // 队列满时优先丢弃最旧日志，避免调试日志反过来拖垮主进程。
-      while (pendingLines.length > 0 && (pendingLines.length >= DEBUG_LOG_MAX_QUEUE_LINES || pendingBytes + lineBytes > DEBUG_LOG_MAX_QUEUE_BYTES)) {
-        const dropped = pendingLines.shift()
-        if (typeof dropped === 'string') pendingBytes = Math.max(0, pendingBytes - Buffer.byteLength(dropped, 'utf8'))
-      }
-    }
-
-    pendingLines.push(line)
-    pendingBytes += lineBytes
-    scheduleFlush()
-  } catch {
-    // ignore
-  }
+    data,
+  })
+  scheduleFlush()
 }
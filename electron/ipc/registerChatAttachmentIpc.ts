@@ -68,7 +68,9 @@ export class ChatAttachmentIpcService {
     this.registry = new LocalMediaRegistry({
       allowedRoots: MANAGED_MEDIA_DIRECTORIES.map((directory) => path.join(userDataDir, directory)),
     })
-    this.server = new LocalMediaServer(this.registry)
+    this.server = new LocalMediaServer(this.registry, {
+      thumbnailDir: path.join(userDataDir, 'media-thumbnails'),
+    })
   }
 
   private parseReference(payload: unknown): LocalMediaReference {
@@ -8,6 +8,9 @@ export const IPC_CHANNEL_PERMISSIONS = {
   'debug:getPath': ['settings'],
   'debug:clear': ['settings'],
   'debug:append': ['pet', 'chat'],
+  'trace:getSnapshot': ['memory'],
+  'trace:export': ['memory'],
+  'trace:reportLag': ALL_WINDOWS,
 
   'settings:get': ALL_WINDOWS,
   'settings:consumeNavigation': ['settings'],
@@ -23,6 +23,85 @@ export type Live2dModelMetadata = {
 
 const live2dModelMetadataCache = new Map<string, Live2dModelMetadata>()
 
+// 解析结果持久缓存：除进程内 Map 外再落一份到 userData，按解析时读过的每个源文件
+// （model3.json、DisplayInfo、各表情文件）的 mtime 做失效判断。命中时只需对这些文件
+// 各做一次 stat，比重新 read + JSON.parse 便宜得多；任何一个文件变化/缺失都整条重解析。
+type PersistedLive2dMetadataEntry = {
+  sourceMtimes: Record<string, number>
+  metadata: Live2dModelMetadata
+}
+
+type MetadataCacheFile = {
+  version: 1
+  entries: Record<string, PersistedLive2dMetadataEntry>
+}
+
+const METADATA_CACHE_FILE_NAME = 'live2d-metadata-cache.json'
+const METADATA_CACHE_PERSIST_DELAY_MS = 250
+
+let persistedMetadataEntries: Record<string, PersistedLive2dMetadataEntry> | null = null
+let metadataPersistTimer: NodeJS.Timeout | null = null
+
+function getMetadataCachePath(): string | null {
+  try {
+    return path.join(app.getPath('userData'), METADATA_CACHE_FILE_NAME)
+  } catch {
+    return null
+  }
+}
+
+function loadPersistedMetadata(): Record<string, PersistedLive2dMetadataEntry> {
+  if (persistedMetadataEntries) return persistedMetadataEntries
+  persistedMetadataEntries = {}
+  const cachePath = getMetadataCachePath()
+  if (!cachePath) return persistedMetadataEntries
+  try {
+    const parsed = JSON.parse(fs.readFileSync(cachePath, 'utf-8')) as MetadataCacheFile
+    if (parsed && parsed.version === 1 && parsed.entries && typeof parsed.entries === 'object') {
+      persistedMetadataEntries = parsed.entries
+    }
+  } catch {
+    // 缓存损坏或不存在都按空缓存处理
+  }
+  return persistedMetadataEntries
+}
+
+// 预热阶段会连续解析几十个模型，落盘合并到一个短定时器里
+function schedulePersistMetadata(): void {
+  if (metadataPersistTimer) return
+  metadataPersistTimer = setTimeout(() => {
+    metadataPersistTimer = null
+    const cachePath = getMetadataCachePath()
+    if (!cachePath || !persistedMetadataEntries) return
+    try {
+      const payload: MetadataCacheFile = { version: 1, entries: persistedMetadataEntries }
+      const temporaryPath = `${cachePath}.${process.pid}.tmp`
+      fs.writeFileSync(temporaryPath, JSON.stringify(payload), 'utf-8')
+      fs.renameSync(temporaryPath, cachePath)
+    } catch {
+      // ignore
+    }
+  }, METADATA_CACHE_PERSIST_DELAY_MS)
+  ;(metadataPersistTimer as unknown as { unref?: () => void }).unref?.()
+}
+
+function fileMtimeMs(filePath: string): number | null {
+  try {
+    return fs.statSync(filePath).mtimeMs
+  } catch {
+    return null
+  }
+}
+
+function isPersistedEntryFresh(entry: PersistedLive2dMetadataEntry): boolean {
+  const paths = Object.keys(entry.sourceMtimes)
+  if (paths.length === 0) return false
+  for (const filePath of paths) {
+    if (fileMtimeMs(filePath) !== entry.sourceMtimes[filePath]) return false
+  }
+  return true
+}
+
 function clampText(value: unknown, maxLen: number): string {
   const s = typeof value === 'string' ? value : String(value ?? '')
   const t = s.trim()
@@ -114,14 +193,29 @@ export function readLive2dModelMetadata(modelFileUrl: string): Live2dModelMetada
   const resolved = resolveModelJsonFilePath(raw)
   if (!resolved) return null
 
+  const persisted = loadPersistedMetadata()
+  const persistedEntry = persisted[raw]
+  if (persistedEntry && isPersistedEntryFresh(persistedEntry)) {
+    live2dModelMetadataCache.set(raw, persistedEntry.metadata)
+    return persistedEntry.metadata
+  }
+
+  const sourceMtimes: Record<string, number> = {}
+  const recordSourceMtime = (filePath: string) => {
+    const mtime = fileMtimeMs(filePath)
+    if (mtime != null) sourceMtimes[filePath] = mtime
+  }
+
   const modelJson = safeReadJson(resolved.modelJsonPath)
   if (!modelJson) return null
+  recordSourceMtime(resolved.modelJsonPath)
 
   const fileRefs = isPlainObject(modelJson.FileReferences) ? (modelJson.FileReferences as Record<string, unknown>) : {}
 
   const displayInfoRel = typeof fileRefs.DisplayInfo === 'string' ? fileRefs.DisplayInfo : ''
   const displayInfoPath = displayInfoRel ? path.join(resolved.modelDir, displayInfoRel) : ''
   const parameterDisplayNames = displayInfoPath ? parseDisplayInfo(displayInfoPath) : {}
+  if (displayInfoPath) recordSourceMtime(displayInfoPath)
 
   const expressionsRaw = fileRefs.Expressions
   const expressionsArr = Array.isArray(expressionsRaw) ? (expressionsRaw as unknown[]) : []
@@ -133,6 +227,7 @@ export function readLive2dModelMetadata(modelFileUrl: string): Live2dModelMetada
     if (!name || !file) continue
     const filePath = path.join(resolved.modelDir, file)
     const params = parseExpression(filePath)
+    recordSourceMtime(filePath)
     expressions.push({ name, file, params })
     if (expressions.length >= 80) break
   }
@@ -151,6 +246,23 @@ export function readLive2dModelMetadata(modelFileUrl: string): Live2dModelMetada
   }
 
   live2dModelMetadataCache.set(raw, meta)
+  persisted[raw] = { sourceMtimes, metadata: meta }
+  schedulePersistMetadata()
   return meta
 }
 
+/**
+ * 后台增量预热：默认模型已经显示后，逐个解析给定模型的元数据写进持久缓存，
+ * 模型之间让出事件循环，避免一次性解析几十个 model3.json 阻塞主进程。
+ */
+export async function prewarmLive2dModelMetadata(modelFileUrls: string[]): Promise<void> {
+  for (const url of modelFileUrls) {
+    try {
+      readLive2dModelMetadata(url)
+    } catch {
+      // 单个模型解析失败不影响其余预热
+    }
+    await new Promise((resolve) => setImmediate(resolve))
+  }
+}
+
@@ -1,9 +1,46 @@
-import { createReadStream } from 'node:fs'
+import { createHash } from 'node:crypto'
+import { createReadStream, promises as fs } from 'node:fs'
 import http from 'node:http'
+import os from 'node:os'
+import path from 'node:path'
 import { LocalMediaError, LocalMediaRegistry, type LocalMediaReference, type LocalMediaResource } from './localMediaRegistry'
 
 export type ByteRange = { start: number; end: number }
 
+// 缩略图只按固定档位生成，?w= 向上取整到最近档位，避免任意宽度把缓存撑爆
+const THUMBNAIL_WIDTH_TIERS = [160, 320, 480, 768, 1024]
+
+export type LocalMediaResizeImage = (sourcePath: string, width: number) => Promise<Buffer | null>
+
+export type LocalMediaServerOptions = {
+  maxRangeBytes?: number
+  /** 缩略图缓存目录（默认放系统临时目录） */
+  thumbnailDir?: string
+  /** 缩略图生成器；返回 null 表示不适合缩放（交回原图路径） */
+  resizeImage?: LocalMediaResizeImage
+}
+
+export function pickThumbnailWidth(value: string | null): number | null {
+  const requested = Number(String(value ?? '').trim())
+  if (!Number.isFinite(requested) || requested <= 0) return null
+  for (const tier of THUMBNAIL_WIDTH_TIERS) {
+    if (requested <= tier) return tier
+  }
+  return THUMBNAIL_WIDTH_TIERS[THUMBNAIL_WIDTH_TIERS.length - 1]
+}
+
+// 默认用 Electron nativeImage 缩放：主进程自带、无额外依赖。
+// 动态 import 让该模块在纯 Node 环境（测试）下也能加载。
+async function resizeWithNativeImage(sourcePath: string, width: number): Promise<Buffer | null> {
+  const { nativeImage } = await import('electron')
+  const image = nativeImage.createFromPath(sourcePath)
+  if (image.isEmpty()) return null
+  const size = image.getSize()
+  if (!size.width || size.width <= width) return null
+  const resized = image.resize({ width, quality: 'good' })
+  return path.extname(sourcePath).toLowerCase() === '.png' ? resized.toPNG() : Buffer.from(resized.toJPEG(82))
+}
+
 export function parseSingleByteRange(value: string, size: number, maxRangeBytes = 16 * 1024 * 1024): ByteRange | null {
   const raw = String(value ?? '').trim()
   if (!raw || !Number.isSafeInteger(size) || size <= 0 || raw.includes(',')) return null
@@ -39,9 +76,75 @@ export class LocalMediaServer {
 
   constructor(
     private readonly registry: LocalMediaRegistry,
-    private readonly options: { maxRangeBytes?: number } = {},
+    private readonly options: LocalMediaServerOptions = {},
   ) {}
 
+  private get thumbnailDir(): string {
+    return this.options.thumbnailDir ?? path.join(os.tmpdir(), 'neodeskpet-media-thumbnails')
+  }
+
+  /**
+   * 缩略图命中/生成成功时直接响应并返回 true；
+   * 不适用（非图片、gif 动图、缩放失败）时返回 false，让调用方走原图路径。
+   */
+  private async tryServeThumbnail(
+    res: http.ServerResponse,
+    resource: LocalMediaResource,
+    width: number,
+    method: string,
+  ): Promise<boolean> {
+    if (resource.kind !== 'image') return false
+    if (resource.mimeType === 'image/gif') return false
+
+    const isPng = resource.mimeType === 'image/png'
+    const mimeType = isPng ? 'image/png' : 'image/jpeg'
+    const sendHeaders = (length: number) => {
+      res.setHeader('Content-Type', mimeType)
+      res.setHeader('X-Content-Type-Options', 'nosniff')
+      res.setHeader('Cache-Control', 'private, no-store')
+      res.setHeader('Content-Length', String(length))
+    }
+
+    try {
+      const stat = await fs.stat(resource.realPath)
+      const pathHash = createHash('sha1').update(resource.realPath).digest('hex').slice(0, 16)
+      const cacheName = `${pathHash}-w${width}-m${Math.trunc(stat.mtimeMs)}${isPng ? '.png' : '.jpg'}`
+      const cachePath = path.join(this.thumbnailDir, cacheName)
+
+      const cachedStat = await fs.stat(cachePath).catch(() => null)
+      if (cachedStat?.isFile()) {
+        sendHeaders(cachedStat.size)
+        if (method === 'HEAD') {
+          res.end()
+          return true
+        }
+        const stream = createReadStream(cachePath)
+        stream.on('error', () => res.destroy())
+        stream.pipe(res)
+        return true
+      }
+
+      const resize = this.options.resizeImage ?? resizeWithNativeImage
+      const buffer = await resize(resource.realPath, width)
+      if (!buffer || buffer.length === 0) return false
+
+      await fs.mkdir(this.thumbnailDir, { recursive: true })
+      // 同文件旧 mtime 的变体已失效，顺手清掉
+      const staleNames = (await fs.readdir(this.thumbnailDir).catch(() => []))
+        .filter((name) => name.startsWith(`${pathHash}-w${width}-`) && name !== cacheName)
+      for (const name of staleNames) await fs.rm(path.join(this.thumbnailDir, name), { force: true }).catch(() => undefined)
+      const tmpPath = `${cachePath}.${process.pid}.tmp`
+      await fs.writeFile(tmpPath, buffer)
+      await fs.rename(tmpPath, cachePath).catch(() => fs.rm(tmpPath, { force: true }))
+
+      sendHeaders(buffer.length)
+      res.end(method === 'HEAD' ? undefined : buffer)
+      return true
+    } catch {
+      return false
+    }
+  }
+
   private async handleRequest(req: http.IncomingMessage, res: http.ServerResponse): Promise<void> {
     const method = String(req.method ?? 'GET').toUpperCase()
     if (method !== 'GET' && method !== 'HEAD') {
@@ -68,6 +171,10 @@ export class LocalMediaServer {
       return
     }
 
+    // ?w= 请求缩略图档位：预览场景拉千字节级的小图而不是整张原图
+    const width = pickThumbnailWidth(url.searchParams.get('w'))
+    if (width !== null && (await this.tryServeThumbnail(res, resource, width, method))) return
+
     res.setHeader('Content-Type', resource.mimeType)
     res.setHeader('X-Content-Type-Options', 'nosniff')
     res.setHeader('Cache-Control', 'private, no-store')
@@ -14,21 +14,25 @@ import { fileURLToPath } from 'node:url'
 import { spawn, type ChildProcess } from 'node:child_process'
 import * as fs from 'node:fs/promises'
 import path from 'node:path'
-import { getSettings, initializeSettingsStore, installSettingsSecretAdapter, setSettings } from './store'
+import { flushSettingsWrites, getSettings, initializeSettingsStore, installSettingsSecretAdapter, setSettings } from './store'
 import { createUserDataBackup, SettingsMigrationProtectionError } from './settingsMigrationSafety'
 import { createTray } from './tray'
 import { WindowManager } from './windowManager'
 import { setWindowManagerInstance } from './runtimeRefs'
 import { scanLive2dModels } from './modelScanner'
+import { prewarmLive2dModelMetadata } from './live2dModelMetadata'
 import { TaskService } from './taskService'
 import { setLive2dCapabilitiesFromRenderer } from './live2dToolState'
 import { closeAllBrowserControlServices } from './browserControlService'
+import { disposeScreenCaptureSession } from './screenCaptureService'
 import {
   addChatMessage,
   clearChatSession,
+  closeChatStore,
   createChatSession,
   deleteChatMessage,
   deleteChatSession,
+  flushChatStore,
   getChatSession,
   listChatSessions,
   renameChatSession,
@@ -50,8 +54,9 @@ import type {
   SettingsNavigationTarget,
 } from './types'
 import { MemoryService } from './memoryService'
-import { McpManager } from './mcpManager'
+import { McpManager, createMcpManifestFileStore } from './mcpManager'
 import { appendDebugLog, clearDebugLog, getDebugLogPath, initDebugLog, isDebugLogEnabled } from './debugLog'
+import { exportChromeTrace, getTraceSnapshot, recordEventLoopLag, startEventLoopLagSampler, startSpan } from './tracing'
 import { AIHttpProxy, resolveAiCredential } from './aiHttpProxy'
 import { createRendererSettings } from './rendererSettings'
 import {
@@ -314,7 +319,8 @@ function startLive2dMouseTrackingPump(): void {
       const nx = active ? clamp((cursor.x - cx) / (w / 2), -1, 1) : 0
       const ny = active ? clamp((cursor.y - cy) / (h / 2), -1, 1) : 0
 
-      petWin.webContents.send('live2d:mouseTarget', { x: nx, y: ny, t: Date.now() })
+      // 经 windowManager 的帧批处理通道发送：与穿透探针坐标合并为每帧一条二进制消息
+      windowManager.sendPetFrame({ mouseTarget: { x: nx, y: ny, t: Date.now() } })
     } catch {
       // ignore
     }
@@ -796,10 +802,18 @@ function handleIpc<Args extends unknown[], Result>(
 ): void {
   ipcMain.handle(channel, (event, ...args) => {
     assertIpcEventTrusted(channel, event)
-    const result = listener(event, ...(args as Args))
+    const endSpan = startSpan('ipc', channel)
+    let result: Result
+    try {
+      result = listener(event, ...(args as Args))
+    } catch (err) {
+      endSpan()
+      throw err
+    }
     if (result instanceof Promise) {
-      return result.then((value) => protectIpcResult(channel, value))
+      return result.finally(endSpan).then((value) => protectIpcResult(channel, value))
     }
+    endSpan()
     return protectIpcResult(channel, result)
   })
 }
@@ -814,7 +828,12 @@ function onIpc<Args extends unknown[]>(
     } catch {
       return
     }
-    listener(event, ...(args as Args))
+    const endSpan = startSpan('ipc', channel)
+    try {
+      listener(event, ...(args as Args))
+    } finally {
+      endSpan()
+    }
   })
 }
 
@@ -831,6 +850,15 @@ function registerIpc() {
     appendDebugLog('renderer', event, p.data)
   })
 
+  // 追踪面板：IPC/工具/记忆 span 的分位数快照，以及 Chrome trace 格式导出
+  handleIpc('trace:getSnapshot', () => getTraceSnapshot())
+  handleIpc('trace:export', () => exportChromeTrace())
+  onIpc('trace:reportLag', (event, lagMs: unknown) => {
+    if (typeof lagMs !== 'number' || !Number.isFinite(lagMs)) return
+    const windowType = windowManager.getWindowTypeByWebContentsId(event.sender.id) ?? 'unknown'
+    recordEventLoopLag(`renderer:${windowType}`, lagMs)
+  })
+
   registerSettingsIpc({
     handle: handleIpc,
     getSettings,
@@ -972,6 +1000,20 @@ app.on('before-quit', (event) => {
     /* ignore */
   }
 
+  // 聊天写回日志在退出流程最早的钩子里同步落盘，避免窗口销毁后丢失未刷批次
+  try {
+    flushChatStore()
+  } catch (_) {
+    /* ignore */
+  }
+
+  // 设置写入是防抖落盘的，退出前把防抖窗口内的改动同步刷进文件
+  try {
+    flushSettingsWrites()
+  } catch (_) {
+    /* ignore */
+  }
+
   if (!browserControlServicesClosed) {
     event.preventDefault()
     void closeBrowserControlServicesOnce().finally(() => {
@@ -985,6 +1027,11 @@ app.on('before-quit', (event) => {
 
 app.on('will-quit', () => {
   globalShortcut.unregisterAll()
+  try {
+    closeChatStore()
+  } catch (_) {
+    /* ignore */
+  }
   aiHttpProxy.close()
   ttsIpc.close()
   windowIpc.close()
@@ -994,6 +1041,7 @@ app.on('will-quit', () => {
     live2dMouseTrackingTimer = null
   }
   void stopManagedAsrApi('app:will-quit')
+  disposeScreenCaptureSession()
   void mcpManager?.sync({ enabled: false, servers: [] })
 })
 
@@ -1029,6 +1077,9 @@ app.whenReady().then(async () => {
     console.info(`[DebugLog] enabled, path=${getDebugLogPath()}`)
   }
 
+  // 主进程事件循环卡顿采样：定位"宠物卡了一下"到底是主进程还是某个渲染进程
+  startEventLoopLagSampler('main')
+
   process.on('uncaughtException', (err) => {
     try {
       appendDebugLog('main', 'process.uncaughtException', {
@@ -1096,7 +1147,9 @@ app.whenReady().then(async () => {
   }
 
   try {
-    mcpManager = new McpManager()
+    mcpManager = new McpManager({
+      manifestStore: createMcpManifestFileStore(path.join(app.getPath('userData'), 'mcp-tool-manifest.json')),
+    })
     mcpManager.onChanged((snap) => broadcastMcpChanged(snap))
     void mcpManager.sync(getSettings().mcp)
   } catch (err) {
@@ -1137,7 +1190,8 @@ app.whenReady().then(async () => {
   // 批次跑满说明仍有积压则短延时续跑；另有低频兜底扫描收漏网（如失败重试、
   // 中途开启 vector/kg 后的历史数据补索引）。
   const TAG_BATCH = 80
-  const VEC_BATCH = 8
+  // 向量批次由 maintainer 内部切成并发的 /embeddings 请求，大批次摊薄调度与扫描开销
+  const VEC_BATCH = 64
   const KG_BATCH = 2
 
   let tagMaintRunning = false
@@ -1262,6 +1316,11 @@ app.whenReady().then(async () => {
     console.error('[ChatStore] warmup failed:', err)
   }
 
+  // 预热 AI 网关连接：提前握好 TCP+TLS 停驻在 keep-alive 池，首回合省掉握手延迟
+  void aiHttpProxy.warmUp().then(() => {
+    appendDebugLog('main', 'aiProxy.pool.warmup', aiHttpProxy.getPoolMetrics())
+  })
+
   let displayRecoveryTimer: NodeJS.Timeout | null = null
   const scheduleWindowRecovery = () => {
     if (displayRecoveryTimer) clearTimeout(displayRecoveryTimer)
@@ -1283,6 +1342,21 @@ app.whenReady().then(async () => {
   startLive2dMouseTrackingPump()
   createTray(windowManager)
 
+  // 预热聊天窗口：等启动高峰过去后把 ChatWindow 隐藏建好，托盘/热键首开变成 show+focus
+  windowManager.schedulePrewarmChatWindow()
+
+  // Live2D 元数据后台预热：默认模型已显示，增量解析全部模型并写入持久缓存，
+  // 设置页模型列表和表情工具首次访问时直接命中 mtime 校验过的缓存
+  const live2dPrewarmTimer = setTimeout(() => {
+    try {
+      const models = scanLive2dModels()
+      void prewarmLive2dModelMetadata(models.map((model) => model.modelFile))
+    } catch (err) {
+      console.error('[Live2D] metadata prewarm failed:', err)
+    }
+  }, 5_000)
+  ;(live2dPrewarmTimer as unknown as { unref?: () => void }).unref?.()
+
   globalShortcut.register('CommandOrControl+Alt+C', () => {
     windowManager.ensureChatWindow()
   })
@@ -1,4 +1,6 @@
 import { createHash } from 'node:crypto'
+import { mkdirSync, readFileSync, writeFileSync } from 'node:fs'
+import path from 'node:path'
 import type { Client } from '@modelcontextprotocol/sdk/client/index.js'
 import { Client as McpClient } from '@modelcontextprotocol/sdk/client/index.js'
 import { StdioClientTransport, getDefaultEnvironment } from '@modelcontextprotocol/sdk/client/stdio.js'
@@ -13,6 +15,12 @@ type McpServerRuntime = {
   transport: StdioClientTransport | null
   tools: ToolDefinition[]
   toolSummaries: McpToolSummary[]
+  // 上次成功连接时抓到的工具清单（配置未变时跨会话复用），让懒启动的服务器
+  // 不必 spawn 就能进入 LLM 的工具列表
+  manifestTools: ToolDefinition[]
+  manifestSummaries: McpToolSummary[]
+  lastUsedAt: number
+  idleTimer: ReturnType<typeof setTimeout> | null
   lastError?: string
   stderrTail: string[]
   updatedAt: number
@@ -20,10 +28,58 @@ type McpServerRuntime = {
   stopPromise?: Promise<void>
 }
 
+type McpCachedManifest = {
+  configHash: string
+  tools: ToolDefinition[]
+  toolSummaries: McpToolSummary[]
+  cachedAt: number
+}
+
+export type McpManifestFile = { version: 1; servers: Record<string, McpCachedManifest> }
+
+export type McpManifestStore = {
+  load: () => McpManifestFile | null
+  save: (data: McpManifestFile) => void
+}
+
+export function createMcpManifestFileStore(filePath: string): McpManifestStore {
+  return {
+    load: () => {
+      try {
+        const parsed = JSON.parse(readFileSync(filePath, 'utf8')) as McpManifestFile
+        if (parsed?.version !== 1 || typeof parsed.servers !== 'object' || !parsed.servers) return null
+        return parsed
+      } catch {
+        return null
+      }
+    },
+    save: (data) => {
+      try {
+        mkdirSync(path.dirname(filePath), { recursive: true })
+        writeFileSync(filePath, JSON.stringify(data))
+      } catch {
+        // 清单只是启动加速缓存，写失败不影响功能
+      }
+    },
+  }
+}
+
+// 懒启动服务器空闲多久后自动停掉（分钟，settings.mcp.idleStopMinutes 可覆盖）
+const MCP_IDLE_STOP_DEFAULT_MINUTES = 5
+
 function now(): number {
   return Date.now()
 }
 
+function configHash(cfg: McpServerConfig): string {
+  const argsList = Array.isArray(cfg.args) ? cfg.args : []
+  const env = cfg.env ?? {}
+  const envPairs = Object.keys(env)
+    .sort()
+    .map((k) => `${k}=${env[k]}`)
+  return stableHash(JSON.stringify([cfg.transport, cfg.command ?? '', cfg.cwd ?? '', argsList, envPairs]))
+}
+
 function clampText(text: unknown, max: number): string {
   const s = typeof text === 'string' ? text : String(text ?? '')
   const t = s.trim()
@@ -242,6 +298,13 @@ export class McpManager {
   private currentSettings: McpSettings = { enabled: false, servers: [] }
   private readonly runtimes = new Map<string, McpServerRuntime>()
   private readonly listeners = new Set<(snapshot: McpStateSnapshot) => void>()
+  private readonly manifestStore: McpManifestStore | null
+  private manifestFile: McpManifestFile
+
+  constructor(options?: { manifestStore?: McpManifestStore }) {
+    this.manifestStore = options?.manifestStore ?? null
+    this.manifestFile = this.manifestStore?.load() ?? { version: 1, servers: {} }
+  }
 
   onChanged(listener: (snapshot: McpStateSnapshot) => void): () => void {
     this.listeners.add(listener)
@@ -285,7 +348,7 @@ export class McpManager {
         pid,
         lastError: rt?.lastError,
         stderrTail: rt?.stderrTail?.slice(-30) ?? [],
-        tools: rt?.toolSummaries ?? [],
+        tools: rt?.status === 'connected' ? rt.toolSummaries : (rt?.manifestSummaries ?? []),
         updatedAt: rt?.updatedAt ?? ts,
       })
     }
@@ -295,13 +358,16 @@ export class McpManager {
 
   getToolDefinitions(): ToolDefinition[] {
     const out: ToolDefinition[] = []
+    if (this.currentSettings.enabled === false) return out
     const ordered = Array.isArray(this.currentSettings.servers) ? this.currentSettings.servers : []
     for (const cfg of ordered) {
+      if (cfg.enabled === false) continue
       const id = normalizeServerId(cfg.id) || cfg.id
       const rt = this.runtimes.get(id)
       if (!rt) continue
-      if (rt.status !== 'connected') continue
-      out.push(...(rt.tools ?? []))
+      // 未连接的懒启动服务器用缓存清单兜底，工具发现不触发 spawn
+      if (rt.status === 'connected') out.push(...(rt.tools ?? []))
+      else out.push(...(rt.manifestTools ?? []))
     }
     return out
   }
@@ -331,19 +397,71 @@ export class McpManager {
       return
     }
 
-    // apply per-server
+    // apply per-server：warm 服务器立即拉起并常驻，其余只登记配置 + 缓存的
+    // 工具清单，等首次工具调用再 spawn
     for (const cfg of servers) {
       const id = normalizeServerId(cfg.id) || cfg.id
       if (cfg.enabled === false) {
         await this.stopServer(id)
         continue
       }
-      await this.startServer({ ...cfg, id })
+      if (cfg.warm === true) {
+        await this.startServer({ ...cfg, id })
+        continue
+      }
+      await this.registerLazyServer({ ...cfg, id })
     }
 
     this.emitChanged()
   }
 
+  private async registerLazyServer(cfg: McpServerConfig): Promise<void> {
+    const rt = this.ensureRuntime(cfg.id, cfg)
+
+    // 已在运行且配置未变就保持现状（可能正被使用）；配置变了先停，下次调用按新配置拉起
+    if (rt.status !== 'disconnected' && !this.sameConfig(rt.config, cfg)) {
+      await this.stopServer(cfg.id)
+    }
+    rt.config = cfg
+
+    const cached = this.manifestFile.servers[cfg.id]
+    if (cached && cached.configHash === configHash(cfg)) {
+      rt.manifestTools = cached.tools
+      rt.manifestSummaries = cached.toolSummaries
+    } else {
+      rt.manifestTools = []
+      rt.manifestSummaries = []
+    }
+    rt.updatedAt = now()
+  }
+
+  private saveManifest(serverId: string, cfg: McpServerConfig, tools: ToolDefinition[], toolSummaries: McpToolSummary[]): void {
+    this.manifestFile.servers[serverId] = { configHash: configHash(cfg), tools, toolSummaries, cachedAt: now() }
+    this.manifestStore?.save(this.manifestFile)
+  }
+
+  private scheduleIdleStop(serverId: string): void {
+    const rt = this.runtimes.get(serverId)
+    if (!rt) return
+    if (rt.config.warm === true) return
+
+    const minutes = this.currentSettings.idleStopMinutes
+    const idleMs = Math.max(1, Math.trunc(typeof minutes === 'number' && Number.isFinite(minutes) ? minutes : MCP_IDLE_STOP_DEFAULT_MINUTES)) * 60_000
+
+    if (rt.idleTimer) clearTimeout(rt.idleTimer)
+    const timer = setTimeout(() => {
+      rt.idleTimer = null
+      // 定时器挂起期间又被用过就顺延，不打断活跃会话
+      if (now() - rt.lastUsedAt < idleMs) {
+        this.scheduleIdleStop(serverId)
+        return
+      }
+      if (rt.status === 'connected') void this.stopServer(serverId)
+    }, idleMs)
+    timer.unref?.()
+    rt.idleTimer = timer
+  }
+
   private sameConfig(a: McpServerConfig, b: McpServerConfig): boolean {
     if (a.transport !== b.transport) return false
     if ((a.command ?? '') !== (b.command ?? '')) return false
@@ -377,6 +495,10 @@ export class McpManager {
       transport: null,
       tools: [],
       toolSummaries: [],
+      manifestTools: [],
+      manifestSummaries: [],
+      lastUsedAt: 0,
+      idleTimer: null,
       stderrTail: [],
       updatedAt: now(),
     }
@@ -493,8 +615,13 @@ export class McpManager {
       rt.transport = transport
       rt.tools = toolDefs
       rt.toolSummaries = toolSummaries
+      rt.manifestTools = toolDefs
+      rt.manifestSummaries = toolSummaries
       rt.status = 'connected'
+      rt.lastUsedAt = now()
       rt.updatedAt = now()
+      this.saveManifest(id, cfg, toolDefs, toolSummaries)
+      this.scheduleIdleStop(id)
       this.emitChanged()
     })()
       .catch((err) => {
@@ -516,6 +643,10 @@ export class McpManager {
     const rt = this.runtimes.get(id)
     if (!rt) return
 
+    if (rt.idleTimer) {
+      clearTimeout(rt.idleTimer)
+      rt.idleTimer = null
+    }
     if (rt.status === 'disconnected') return
     if (rt.stopPromise) return rt.stopPromise
 
@@ -554,11 +685,27 @@ export class McpManager {
     if (this.currentSettings.enabled === false) throw new Error('MCP disabled')
 
     const serverId = normalizeServerId(parsed.serverId) || parsed.serverId
-    const rt = this.runtimes.get(serverId)
-    if (!rt || rt.status !== 'connected' || !rt.client) throw new Error(`MCP server not connected: ${serverId}`)
+    let rt = this.runtimes.get(serverId)
+
+    // 懒启动：服务器未在运行时按当前配置现场拉起（首次调用多付一次冷启动，后续命中常驻进程）
+    if (!rt || rt.status !== 'connected' || !rt.client) {
+      const cfg = (Array.isArray(this.currentSettings.servers) ? this.currentSettings.servers : []).find(
+        (s) => (normalizeServerId(s.id) || s.id) === serverId,
+      )
+      if (!cfg || cfg.enabled === false) throw new Error(`MCP server not connected: ${serverId}`)
+      await this.startServer({ ...cfg, id: serverId })
+      rt = this.runtimes.get(serverId)
+      if (!rt || rt.status !== 'connected' || !rt.client) {
+        throw new Error(`MCP server not connected: ${serverId}${rt?.lastError ? ` (${rt.lastError})` : ''}`)
+      }
+    }
+
+    rt.lastUsedAt = now()
+    this.scheduleIdleStop(serverId)
 
     const args = typeof input === 'object' && input && !Array.isArray(input) ? (input as Record<string, unknown>) : { value: input }
     const res = await (rt.client as McpClient).callTool({ name: parsed.rawToolName, arguments: args })
+    rt.lastUsedAt = now()
 
     const isError =
       typeof res === 'object' &&
@@ -0,0 +1,354 @@
+// 近似最近邻（IVF）索引：粗聚类中心 + 倒排列表，探测若干最近簇后在簇内做精确点积评分。
+// 纯 TS 实现、无原生依赖；序列化为紧凑二进制，持久化在 SQLite 文件旁，跨进程重启复用。
+// 向量默认已归一化（与 memory_embedding 写入侧一致），因此点积即余弦相似度。
+
+export type AnnEntry = {
+  rowid: number
+  personaId: string | null
+  createdAt: number
+  vec: Float32Array
+}
+
+export type AnnSearchArgs = {
+  personaId: string
+  includeShared: boolean
+  topK: number
+  minScore: number
+  nProbe?: number
+}
+
+export type AnnHit = { rowid: number; sim: number }
+
+type AnnList = {
+  centroid: Float32Array
+  rowids: number[]
+  personaIds: (string | null)[]
+  createdAts: number[]
+  vectors: Float32Array[]
+}
+
+const MAGIC = 0x4e_44_50_41 // 'NDPA'
+const FORMAT_VERSION = 1
+const MAX_LISTS = 1024
+const SPLIT_THRESHOLD = 2048
+
+function clampInt(value: number, min: number, max: number): number {
+  return Math.max(min, Math.min(max, Math.trunc(value)))
+}
+
+function dot(a: Float32Array, b: Float32Array): number {
+  let sum = 0
+  for (let i = 0; i < a.length; i++) sum += a[i] * b[i]
+  return sum
+}
+
+function normalizeInPlace(vec: Float32Array): void {
+  let norm = 0
+  for (let i = 0; i < vec.length; i++) norm += vec[i] * vec[i]
+  norm = Math.sqrt(norm)
+  if (norm <= 1e-12) return
+  for (let i = 0; i < vec.length; i++) vec[i] /= norm
+}
+
+export class MemoryAnnIndex {
+  readonly model: string
+  readonly dims: number
+  /** 最近一次纳入索引的 updated_at 水位线，增量更新时只拉取更新的行。 */
+  watermark = 0
+
+  private readonly lists: AnnList[] = []
+  private readonly listByRowid = new Map<number, number>()
+
+  constructor(model: string, dims: number) {
+    this.model = model
+    this.dims = dims
+  }
+
+  get size(): number {
+    return this.listByRowid.size
+  }
+
+  has(rowid: number): boolean {
+    return this.listByRowid.has(rowid)
+  }
+
+  rowids(): number[] {
+    return [...this.listByRowid.keys()]
+  }
+
+  static build(model: string, dims: number, entries: AnnEntry[]): MemoryAnnIndex {
+    const index = new MemoryAnnIndex(model, dims)
+    if (entries.length === 0) return index
+
+    const numLists = clampInt(Math.round(Math.sqrt(entries.length)), 1, MAX_LISTS)
+    const step = entries.length / numLists
+    for (let i = 0; i < numLists; i++) {
+      const seed = entries[Math.min(entries.length - 1, Math.floor(i * step))]
+      index.lists.push({
+        centroid: Float32Array.from(seed.vec),
+        rowids: [],
+        personaIds: [],
+        createdAts: [],
+        vectors: [],
+      })
+    }
+
+    // 一轮 Lloyd 迭代足够让簇心离开采样偏差，索引只需粗分桶而非精确聚类
+    if (numLists > 1) {
+      const sums = index.lists.map(() => new Float64Array(dims))
+      const counts = new Array<number>(numLists).fill(0)
+      for (const entry of entries) {
+        const listIndex = index.nearestList(entry.vec)
+        const sum = sums[listIndex]
+        for (let i = 0; i < dims; i++) sum[i] += entry.vec[i]
+        counts[listIndex]++
+      }
+      for (let listIndex = 0; listIndex < numLists; listIndex++) {
+        if (counts[listIndex] === 0) continue
+        const centroid = index.lists[listIndex].centroid
+        const sum = sums[listIndex]
+        for (let i = 0; i < dims; i++) centroid[i] = sum[i] / counts[listIndex]
+        normalizeInPlace(centroid)
+      }
+    }
+
+    for (const entry of entries) index.insert(entry)
+    return index
+  }
+
+  insert(entry: AnnEntry): void {
+    if (entry.vec.length !== this.dims) return
+    this.remove(entry.rowid)
+    if (this.lists.length === 0) {
+      this.lists.push({
+        centroid: Float32Array.from(entry.vec),
+        rowids: [],
+        personaIds: [],
+        createdAts: [],
+        vectors: [],
+      })
+    }
+    const listIndex = this.nearestList(entry.vec)
+    const list = this.lists[listIndex]
+    list.rowids.push(entry.rowid)
+    list.personaIds.push(entry.personaId)
+    list.createdAts.push(entry.createdAt)
+    list.vectors.push(entry.vec)
+    this.listByRowid.set(entry.rowid, listIndex)
+    if (list.rowids.length > SPLIT_THRESHOLD && this.lists.length < MAX_LISTS) this.splitList(listIndex)
+  }
+
+  remove(rowid: number): boolean {
+    const listIndex = this.listByRowid.get(rowid)
+    if (listIndex === undefined) return false
+    const list = this.lists[listIndex]
+    const offset = list.rowids.indexOf(rowid)
+    if (offset >= 0) {
+      const last = list.rowids.length - 1
+      if (offset !== last) {
+        list.rowids[offset] = list.rowids[last]
+        list.personaIds[offset] = list.personaIds[last]
+        list.createdAts[offset] = list.createdAts[last]
+        list.vectors[offset] = list.vectors[last]
+        this.listByRowid.set(list.rowids[offset], listIndex)
+      }
+      list.rowids.pop()
+      list.personaIds.pop()
+      list.createdAts.pop()
+      list.vectors.pop()
+    }
+    this.listByRowid.delete(rowid)
+    return true
+  }
+
+  search(query: Float32Array, args: AnnSearchArgs): AnnHit[] {
+    if (query.length !== this.dims || this.lists.length === 0) return []
+    const nProbe = clampInt(
+      args.nProbe ?? Math.max(8, Math.ceil(this.lists.length / 4)),
+      1,
+      this.lists.length,
+    )
+
+    const probeOrder = this.lists
+      .map((list, listIndex) => ({ listIndex, sim: dot(query, list.centroid) }))
+      .sort((a, b) => b.sim - a.sim)
+      .slice(0, nProbe)
+
+    const scored: Array<AnnHit & { createdAt: number }> = []
+    for (const probe of probeOrder) {
+      const list = this.lists[probe.listIndex]
+      for (let i = 0; i < list.rowids.length; i++) {
+        const personaId = list.personaIds[i]
+        if (personaId !== args.personaId && !(args.includeShared && personaId === null)) continue
+        const sim = dot(query, list.vectors[i])
+        if (!Number.isFinite(sim) || sim < args.minScore) continue
+        scored.push({ rowid: list.rowids[i], sim, createdAt: list.createdAts[i] })
+      }
+    }
+
+    scored.sort((a, b) => b.sim - a.sim || b.createdAt - a.createdAt || b.rowid - a.rowid)
+    return scored.slice(0, args.topK).map((hit) => ({ rowid: hit.rowid, sim: hit.sim }))
+  }
+
+  serialize(): Buffer {
+    const modelBytes = Buffer.from(this.model, 'utf8')
+    let byteLength = 4 + 4 + 4 + 8 + 4 + modelBytes.length + 4
+    for (const list of this.lists) {
+      byteLength += this.dims * 4 + 4
+      for (let i = 0; i < list.rowids.length; i++) {
+        const personaBytes = list.personaIds[i] === null ? 0 : Buffer.byteLength(list.personaIds[i] as string, 'utf8')
+        byteLength += 8 + 8 + 4 + personaBytes + this.dims * 4
+      }
+    }
+
+    const buffer = Buffer.allocUnsafe(byteLength)
+    let offset = 0
+    offset = buffer.writeUInt32LE(MAGIC, offset)
+    offset = buffer.writeUInt32LE(FORMAT_VERSION, offset)
+    offset = buffer.writeUInt32LE(this.dims, offset)
+    offset = buffer.writeDoubleLE(this.watermark, offset)
+    offset = buffer.writeUInt32LE(modelBytes.length, offset)
+    offset += modelBytes.copy(buffer, offset)
+    offset = buffer.writeUInt32LE(this.lists.length, offset)
+
+    for (const list of this.lists) {
+      for (let i = 0; i < this.dims; i++) offset = buffer.writeFloatLE(list.centroid[i], offset)
+      offset = buffer.writeUInt32LE(list.rowids.length, offset)
+      for (let i = 0; i < list.rowids.length; i++) {
+        offset = buffer.writeDoubleLE(list.rowids[i], offset)
+        offset = buffer.writeDoubleLE(list.createdAts[i], offset)
+        const personaId = list.personaIds[i]
+        if (personaId === null) {
+          offset = buffer.writeInt32LE(-1, offset)
+        } else {
+          const personaBytes = Buffer.from(personaId, 'utf8')
+          offset = buffer.writeInt32LE(personaBytes.length, offset)
+          offset += personaBytes.copy(buffer, offset)
+        }
+        const vec = list.vectors[i]
+        for (let d = 0; d < this.dims; d++) offset = buffer.writeFloatLE(vec[d], offset)
+      }
+    }
+    return buffer
+  }
+
+  static deserialize(buffer: Buffer): MemoryAnnIndex {
+    let offset = 0
+    const magic = buffer.readUInt32LE(offset)
+    offset += 4
+    if (magic !== MAGIC) throw new Error('ANN 索引文件头无效')
+    const version = buffer.readUInt32LE(offset)
+    offset += 4
+    if (version !== FORMAT_VERSION) throw new Error(`不支持的 ANN 索引版本：${version}`)
+    const dims = buffer.readUInt32LE(offset)
+    offset += 4
+    const watermark = buffer.readDoubleLE(offset)
+    offset += 8
+    const modelLength = buffer.readUInt32LE(offset)
+    offset += 4
+    const model = buffer.toString('utf8', offset, offset + modelLength)
+    offset += modelLength
+    const listCount = buffer.readUInt32LE(offset)
+    offset += 4
+
+    const index = new MemoryAnnIndex(model, dims)
+    index.watermark = watermark
+    for (let listIndex = 0; listIndex < listCount; listIndex++) {
+      const centroid = new Float32Array(dims)
+      for (let i = 0; i < dims; i++) {
+        centroid[i] = buffer.readFloatLE(offset)
+        offset += 4
+      }
+      const entryCount = buffer.readUInt32LE(offset)
+      offset += 4
+      const list: AnnList = { centroid, rowids: [], personaIds: [], createdAts: [], vectors: [] }
+      index.lists.push(list)
+      for (let i = 0; i < entryCount; i++) {
+        const rowid = buffer.readDoubleLE(offset)
+        offset += 8
+        const createdAt = buffer.readDoubleLE(offset)
+        offset += 8
+        const personaLength = buffer.readInt32LE(offset)
+        offset += 4
+        let personaId: string | null = null
+        if (personaLength >= 0) {
+          personaId = buffer.toString('utf8', offset, offset + personaLength)
+          offset += personaLength
+        }
+        const vec = new Float32Array(dims)
+        for (let d = 0; d < dims; d++) {
+          vec[d] = buffer.readFloatLE(offset)
+          offset += 4
+        }
+        list.rowids.push(rowid)
+        list.personaIds.push(personaId)
+        list.createdAts.push(createdAt)
+        list.vectors.push(vec)
+        index.listByRowid.set(rowid, listIndex)
+      }
+    }
+    return index
+  }
+
+  private nearestList(vec: Float32Array): number {
+    let best = 0
+    let bestSim = -Infinity
+    for (let listIndex = 0; listIndex < this.lists.length; listIndex++) {
+      const sim = dot(vec, this.lists[listIndex].centroid)
+      if (sim > bestSim) {
+        bestSim = sim
+        best = listIndex
+      }
+    }
+    return best
+  }
+
+  private splitList(listIndex: number): void {
+    const list = this.lists[listIndex]
+    // 取离原簇心最远的条目做新簇种子，把原簇一分为二后重分配
+    let farthest = 0
+    let farthestSim = Infinity
+    for (let i = 0; i < list.vectors.length; i++) {
+      const sim = dot(list.centroid, list.vectors[i])
+      if (sim < farthestSim) {
+        farthestSim = sim
+        farthest = i
+      }
+    }
+    const newList: AnnList = {
+      centroid: Float32Array.from(list.vectors[farthest]),
+      rowids: [],
+      personaIds: [],
+      createdAts: [],
+      vectors: [],
+    }
+    const newListIndex = this.lists.length
+    this.lists.push(newList)
+
+    const moved: number[] = []
+    for (let i = 0; i < list.vectors.length; i++) {
+      if (dot(newList.centroid, list.vectors[i]) > dot(list.centroid, list.vectors[i])) moved.push(i)
+    }
+    // 从后往前 swap-remove，避免 moved 中靠前的下标失效
+    for (let m = moved.length - 1; m >= 0; m--) {
+      const i = moved[m]
+      newList.rowids.push(list.rowids[i])
+      newList.personaIds.push(list.personaIds[i])
+      newList.createdAts.push(list.createdAts[i])
+      newList.vectors.push(list.vectors[i])
+      this.listByRowid.set(list.rowids[i], newListIndex)
+      const last = list.rowids.length - 1
+      if (i !== last) {
+        list.rowids[i] = list.rowids[last]
+        list.personaIds[i] = list.personaIds[last]
+        list.createdAts[i] = list.createdAts[last]
+        list.vectors[i] = list.vectors[last]
+        this.listByRowid.set(list.rowids[i], listIndex)
+      }
+      list.rowids.pop()
+      list.personaIds.pop()
+      list.createdAts.pop()
+      list.vectors.pop()
+    }
+  }
+}
@@ -1,3 +1,4 @@
+import { statSync } from 'node:fs'
 import { createRequire } from 'node:module'
 import path from 'node:path'
 
@@ -5,6 +6,8 @@ export type MemoryDatabaseHandle = import('better-sqlite3').Database
 
 export type MemoryDatabaseConstructor = new (file: string) => MemoryDatabaseHandle
 
+export type MemoryPreparedStatement = ReturnType<MemoryDatabaseHandle['prepare']>
+
 export type OpenMemoryDatabaseOptions = {
   now?: () => number
   databaseConstructor?: MemoryDatabaseConstructor
@@ -12,6 +15,8 @@ export type OpenMemoryDatabaseOptions = {
 
 export type OpenMemoryDatabaseResult = {
   db: MemoryDatabaseHandle
+  /** 只读第二连接：检索读不排在写事务后面（WAL 下读写互不阻塞） */
+  readDb: MemoryDatabaseHandle
   dbPath: string
 }
 
@@ -22,23 +27,83 @@ export function openMemoryDatabase(
   const Database = options.databaseConstructor ?? loadDatabaseConstructor()
   const dbPath = path.join(userDataDir, 'neodeskpet-memory.sqlite3')
   const db = new Database(dbPath)
+  let readDb: MemoryDatabaseHandle | null = null
 
   try {
     db.pragma('journal_mode = WAL')
     db.pragma('synchronous = NORMAL')
     db.pragma('foreign_keys = ON')
     initializeMemoryDatabase(db, options.now ?? Date.now)
-    return { db, dbPath }
+
+    const profile = pickMemoryCacheProfile(databaseFileSize(dbPath))
+    applyMemoryCacheProfile(db, profile)
+
+    readDb = new Database(dbPath)
+    readDb.pragma('query_only = ON')
+    applyMemoryCacheProfile(readDb, profile)
+
+    return { db, readDb, dbPath }
   } catch (error) {
-    try {
-      db.close()
-    } catch {
-      // Preserve the initialization error that prevented the service from starting.
+    for (const handle of [readDb, db]) {
+      try {
+        handle?.close()
+      } catch {
+        // Preserve the initialization error that prevented the service from starting.
+      }
     }
     throw error
   }
 }
 
+// 按数据库体积分档的页缓存/内存映射配置（cache_size 取负值 = KiB）
+export type MemoryCacheProfile = { cacheKib: number; mmapBytes: number }
+
+const MEMORY_CACHE_PROFILE_TIERS: Array<{ maxBytes: number; profile: MemoryCacheProfile }> = [
+  { maxBytes: 16 * 1024 * 1024, profile: { cacheKib: 4_096, mmapBytes: 32 * 1024 * 1024 } },
+  { maxBytes: 128 * 1024 * 1024, profile: { cacheKib: 16_384, mmapBytes: 128 * 1024 * 1024 } },
+  { maxBytes: Number.POSITIVE_INFINITY, profile: { cacheKib: 65_536, mmapBytes: 256 * 1024 * 1024 } },
+]
+
+export function pickMemoryCacheProfile(dbSizeBytes: number): MemoryCacheProfile {
+  const size = Number.isFinite(dbSizeBytes) && dbSizeBytes > 0 ? dbSizeBytes : 0
+  for (const tier of MEMORY_CACHE_PROFILE_TIERS) {
+    if (size <= tier.maxBytes) return tier.profile
+  }
+  return MEMORY_CACHE_PROFILE_TIERS[MEMORY_CACHE_PROFILE_TIERS.length - 1].profile
+}
+
+function applyMemoryCacheProfile(db: MemoryDatabaseHandle, profile: MemoryCacheProfile): void {
+  db.pragma(`cache_size = -${profile.cacheKib}`)
+  db.pragma(`mmap_size = ${profile.mmapBytes}`)
+}
+
+function databaseFileSize(dbPath: string): number {
+  try {
+    return statSync(dbPath).size
+  } catch {
+    return 0
+  }
+}
+
+const statementRegistries = new WeakMap<MemoryDatabaseHandle, Map<string, MemoryPreparedStatement>>()
+
+/**
+ * 共享预编译语句注册表：同一连接上相同 SQL 只 prepare 一次。
+ * 只用于固定 SQL；带动态占位符（IN 列表等）的语句仍走 db.prepare，避免注册表无界增长。
+ */
+export function preparedStatement(db: MemoryDatabaseHandle, sql: string): MemoryPreparedStatement {
+  let registry = statementRegistries.get(db)
+  if (!registry) {
+    registry = new Map()
+    statementRegistries.set(db, registry)
+  }
+  const cached = registry.get(sql)
+  if (cached) return cached
+  const statement = db.prepare(sql)
+  registry.set(sql, statement)
+  return statement
+}
+
 export function initializeMemoryDatabase(db: MemoryDatabaseHandle, now: () => number = Date.now): void {
   const hadMemoryFts = schemaObjectExists(db, 'table', 'memory_fts')
   const hadKgEntityFts = schemaObjectExists(db, 'table', 'kg_entity_fts')
@@ -261,6 +326,18 @@ const BASE_SCHEMA_SQL = `
   CREATE INDEX IF NOT EXISTS idx_memory_embedding_model ON memory_embedding(model);
   CREATE INDEX IF NOT EXISTS idx_memory_embedding_updated ON memory_embedding(updated_at DESC);
 
+  CREATE TABLE IF NOT EXISTS embedding_cache (
+    model TEXT NOT NULL,
+    content_hash TEXT NOT NULL,
+    dims INTEGER NOT NULL,
+    embedding BLOB NOT NULL,
+    created_at INTEGER NOT NULL,
+    last_used_at INTEGER NOT NULL,
+    PRIMARY KEY(model, content_hash)
+  );
+
+  CREATE INDEX IF NOT EXISTS idx_embedding_cache_last_used ON embedding_cache(last_used_at);
+
   CREATE TABLE IF NOT EXISTS kg_entity (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     persona_id TEXT,
@@ -0,0 +1,90 @@
+import type { MemoryDatabaseHandle } from './memoryDatabase'
+
+// 持久化 embedding 缓存：按（模型, 内容哈希）落库，模型切换或留存清理后的重索引
+// 对未变化的文本可以完全跳过网络请求。容量按 LRU（last_used_at）回收。
+
+export type MemoryEmbeddingCacheStoreOptions = {
+  maxEntries?: number
+  now?: () => number
+}
+
+export class MemoryEmbeddingCacheStore {
+  private readonly db: MemoryDatabaseHandle
+  private readonly maxEntries: number
+  private readonly now: () => number
+
+  constructor(db: MemoryDatabaseHandle, options: MemoryEmbeddingCacheStoreOptions = {}) {
+    this.db = db
+    this.maxEntries = Math.max(1, Math.floor(options.maxEntries ?? 50_000))
+    this.now = options.now ?? Date.now
+  }
+
+  getMany(model: string, hashes: string[]): Map<string, Float32Array> {
+    const found = new Map<string, Float32Array>()
+    if (hashes.length === 0) return found
+
+    const placeholders = hashes.map(() => '?').join(',')
+    const rows = this.db
+      .prepare(
+        `SELECT content_hash as hash, dims, embedding FROM embedding_cache WHERE model = ? AND content_hash IN (${placeholders})`,
+      )
+      .all(model, ...hashes) as Array<{ hash: string; dims: number; embedding: Buffer }>
+
+    for (const row of rows) {
+      const buf = row.embedding
+      if (!buf || Math.floor(buf.byteLength / 4) !== row.dims || row.dims < 8) continue
+      found.set(row.hash, Float32Array.from(new Float32Array(buf.buffer, buf.byteOffset, row.dims)))
+    }
+
+    if (found.size > 0) {
+      const touched = [...found.keys()]
+      this.db
+        .prepare(
+          `UPDATE embedding_cache SET last_used_at = ? WHERE model = ? AND content_hash IN (${touched.map(() => '?').join(',')})`,
+        )
+        .run(this.now(), model, ...touched)
+    }
+    return found
+  }
+
+  putMany(model: string, entries: Array<{ hash: string; vec: Float32Array }>): void {
+    if (entries.length === 0) return
+    const timestamp = this.now()
+    const upsert = this.db.prepare(
+      `
+      INSERT INTO embedding_cache (model, content_hash, dims, embedding, created_at, last_used_at)
+      VALUES (?, ?, ?, ?, ?, ?)
+      ON CONFLICT(model, content_hash) DO UPDATE SET
+        dims = excluded.dims,
+        embedding = excluded.embedding,
+        last_used_at = excluded.last_used_at
+      `,
+    )
+    const transaction = this.db.transaction(() => {
+      for (const entry of entries) {
+        if (!entry.hash || entry.vec.length < 8) continue
+        const buffer = Buffer.from(entry.vec.buffer, entry.vec.byteOffset, entry.vec.byteLength)
+        upsert.run(model, entry.hash, entry.vec.length, buffer, timestamp, timestamp)
+      }
+    })
+    transaction()
+    this.prune()
+  }
+
+  /** 超出容量时按 last_used_at 淘汰最久未使用的条目。 */
+  prune(): number {
+    const row = this.db.prepare('SELECT COUNT(*) as count FROM embedding_cache').get() as { count: number }
+    const excess = row.count - this.maxEntries
+    if (excess <= 0) return 0
+    this.db
+      .prepare(
+        `
+        DELETE FROM embedding_cache WHERE rowid IN (
+          SELECT rowid FROM embedding_cache ORDER BY last_used_at ASC, rowid ASC LIMIT ?
+        )
+        `,
+      )
+      .run(excess)
+    return excess
+  }
+}
@@ -13,9 +13,16 @@ export type MemoryEmbeddedText = {
   vec: Float32Array
 }
 
+/** 持久化缓存接口（见 memoryEmbeddingCache.ts）；注入式依赖，便于测试与按需关闭。 */
+export type MemoryEmbeddingPersistentCache = {
+  getMany: (model: string, hashes: string[]) => Map<string, Float32Array>
+  putMany: (model: string, entries: Array<{ hash: string; vec: Float32Array }>) => void
+}
+
 export type MemoryEmbeddingClientOptions = {
   fetchImpl?: typeof fetch
   maxCacheEntries?: number
+  persistentCache?: MemoryEmbeddingPersistentCache
 }
 
 export function normalizeMemoryEmbeddingText(text: string): string {
@@ -75,10 +82,12 @@ export class MemoryEmbeddingClient {
   private readonly fetchImpl: typeof fetch
   private readonly maxCacheEntries: number
   private readonly cache = new Map<string, Float32Array>()
+  private readonly persistentCache: MemoryEmbeddingPersistentCache | null
 
   constructor(options: MemoryEmbeddingClientOptions = {}) {
     this.fetchImpl = options.fetchImpl ?? fetch
     this.maxCacheEntries = Math.max(1, Math.floor(options.maxCacheEntries ?? 1200))
+    this.persistentCache = options.persistentCache ?? null
   }
 
   clearCache(): void {
@@ -113,6 +122,27 @@ export class MemoryEmbeddingClient {
       requestHashes.push(hash)
     }
 
+    // 内存缓存未命中的先查持久化缓存；持久层故障只降级为多一次网络请求
+    if (this.persistentCache && requestHashes.length > 0) {
+      let persisted: Map<string, Float32Array>
+      try {
+        persisted = this.persistentCache.getMany(config.model, requestHashes)
+      } catch {
+        persisted = new Map()
+      }
+      for (let i = requestHashes.length - 1; i >= 0; i--) {
+        const vec = persisted.get(requestHashes[i])
+        if (!vec) continue
+        const hash = requestHashes[i]
+        this.remember(hash, vec)
+        for (const resultIndex of missingIndices.get(hash) ?? []) {
+          results[resultIndex] = { text: inputs[resultIndex], hash, vec }
+        }
+        requestHashes.splice(i, 1)
+        requestTexts.splice(i, 1)
+      }
+    }
+
     if (requestTexts.length > 0) {
       const response = await this.fetchImpl(config.endpoint, {
         method: 'POST',
@@ -149,14 +179,24 @@ export class MemoryEmbeddingClient {
         ordered[index] = item.embedding
       }
 
+      const freshEntries: Array<{ hash: string; vec: Float32Array }> = []
       for (let i = 0; i < requestHashes.length; i++) {
         const hash = requestHashes[i]
         const vec = normalizeMemoryEmbeddingVector(ordered[i])
         this.remember(hash, vec)
+        freshEntries.push({ hash, vec })
         for (const resultIndex of missingIndices.get(hash) ?? []) {
           results[resultIndex] = { text: inputs[resultIndex], hash, vec }
         }
       }
+
+      if (this.persistentCache && freshEntries.length > 0) {
+        try {
+          this.persistentCache.putMany(config.model, freshEntries)
+        } catch {
+          // 写缓存失败不影响本次结果
+        }
+      }
     }
 
     return results
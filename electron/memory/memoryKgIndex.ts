@@ -1,6 +1,6 @@
 import { createHash } from 'node:crypto'
 import type { AISettings, MemorySettings } from '../types'
-import type { MemoryDatabaseHandle } from './memoryDatabase'
+import { preparedStatement, type MemoryDatabaseHandle } from './memoryDatabase'
 import { MemoryIndexQueue } from './memoryIndexQueue'
 
 export type MemoryKgMaintenanceResult = {
@@ -366,15 +366,15 @@ export class MemoryKgIndexMaintainer {
   }): void {
     const rowid = clampInt(args.memoryRowid, 0, 1, 2_000_000_000)
     if (rowid <= 0) return
-    const exists = this.db.prepare('SELECT 1 FROM memory WHERE rowid = ? LIMIT 1').get(rowid) as
+    const exists = preparedStatement(this.db, 'SELECT 1 FROM memory WHERE rowid = ? LIMIT 1').get(rowid) as
       | { 1: number }
       | undefined
     if (!exists) return
 
     try {
-      this.db
-        .prepare(
-          `
+      preparedStatement(
+        this.db,
+        `
           INSERT INTO kg_memory_index (memory_rowid, persona_id, content_hash, status, last_error, updated_at, extracted_at)
           VALUES (?, ?, ?, ?, ?, ?, ?)
           ON CONFLICT(memory_rowid) DO UPDATE SET
@@ -385,16 +385,15 @@ export class MemoryKgIndexMaintainer {
             updated_at = excluded.updated_at,
             extracted_at = excluded.extracted_at
           `,
-        )
-        .run(
-          rowid,
-          args.personaId.trim() || 'default',
-          args.contentHash,
-          args.status,
-          args.error ?? null,
-          clampInt(args.updatedAt, 0, 0, Number.MAX_SAFE_INTEGER),
-          args.extractedAt,
-        )
+      ).run(
+        rowid,
+        args.personaId.trim() || 'default',
+        args.contentHash,
+        args.status,
+        args.error ?? null,
+        clampInt(args.updatedAt, 0, 0, Number.MAX_SAFE_INTEGER),
+        args.extractedAt,
+      )
     } catch (error) {
       const message = error instanceof Error ? error.message : String(error)
       if (message.includes('FOREIGN KEY constraint failed')) return
@@ -414,13 +413,14 @@ export class MemoryKgIndexMaintainer {
     const personaId = args.personaId.trim() || 'default'
     const rowid = clampInt(args.memoryRowid, 0, 1, 2_000_000_000)
     if (rowid <= 0) return
-    const exists = this.db.prepare('SELECT 1 FROM memory WHERE rowid = ? LIMIT 1').get(rowid) as
+    const exists = preparedStatement(this.db, 'SELECT 1 FROM memory WHERE rowid = ? LIMIT 1').get(rowid) as
       | { 1: number }
       | undefined
     if (!exists) return
 
     const timestamp = args.extractedAt
-    const upsertEntity = this.db.prepare(
+    const upsertEntity = preparedStatement(
+      this.db,
       `
       INSERT INTO kg_entity (persona_id, name, entity_type, aliases_json, key, created_at, updated_at)
       VALUES (?, ?, ?, ?, ?, ?, ?)
@@ -430,15 +430,18 @@ export class MemoryKgIndexMaintainer {
         updated_at = excluded.updated_at
       `,
     )
-    const getEntity = this.db.prepare(
+    const getEntity = preparedStatement(
+      this.db,
       'SELECT id as id FROM kg_entity WHERE persona_id = ? AND key = ? AND entity_type = ? LIMIT 1',
     )
-    const clearMentions = this.db.prepare('DELETE FROM kg_entity_mention WHERE memory_rowid = ?')
-    const insertMention = this.db.prepare(
+    const clearMentions = preparedStatement(this.db, 'DELETE FROM kg_entity_mention WHERE memory_rowid = ?')
+    const insertMention = preparedStatement(
+      this.db,
       'INSERT OR IGNORE INTO kg_entity_mention (entity_id, memory_rowid, created_at) VALUES (?, ?, ?)',
     )
-    const clearRelations = this.db.prepare('DELETE FROM kg_relation WHERE memory_rowid = ?')
-    const insertRelation = this.db.prepare(
+    const clearRelations = preparedStatement(this.db, 'DELETE FROM kg_relation WHERE memory_rowid = ?')
+    const insertRelation = preparedStatement(
+      this.db,
       `
       INSERT OR IGNORE INTO kg_relation (
         persona_id, subject_entity_id, predicate, object_entity_id, object_literal, confidence, memory_rowid, created_at
@@ -1,6 +1,6 @@
 import { randomUUID } from 'node:crypto'
 import type { MemoryRecord } from '../types'
-import type { MemoryDatabaseHandle } from './memoryDatabase'
+import { preparedStatement, type MemoryDatabaseHandle } from './memoryDatabase'
 import { computeMemoryRetentionScore } from './memoryRetrieval'
 
 export type AddMemoryVersionArgs = {
@@ -29,9 +29,9 @@ export class MemoryRecordStore {
   }
 
   getByRowid(rowid: number): MemoryRecord | null {
-    const record = this.db
-      .prepare(
-        `
+    const record = preparedStatement(
+      this.db,
+      `
         SELECT
           rowid as rowid,
           persona_id as personaId,
@@ -53,8 +53,7 @@ export class MemoryRecordStore {
         FROM memory
         WHERE rowid = ?
         `,
-      )
-      .get(rowid) as MemoryRecord | undefined
+    ).get(rowid) as MemoryRecord | undefined
 
     if (!record) return null
     record.retention = computeMemoryRetentionScore(
@@ -68,18 +67,17 @@ export class MemoryRecordStore {
 
   addVersion(args: AddMemoryVersionArgs): void {
     const reason = args.reason.trim() || 'manual_edit'
-    this.db
-      .prepare(
-        'INSERT INTO memory_version (id, memory_rowid, old_content, new_content, reason, source, created_at) VALUES (?, ?, ?, ?, ?, ?, ?)',
-      )
-      .run(
-        this.createId(),
-        args.memoryRowid,
-        args.oldContent,
-        args.newContent,
-        reason,
-        args.source,
-        args.createdAt,
-      )
+    preparedStatement(
+      this.db,
+      'INSERT INTO memory_version (id, memory_rowid, old_content, new_content, reason, source, created_at) VALUES (?, ?, ?, ?, ?, ?, ?)',
+    ).run(
+      this.createId(),
+      args.memoryRowid,
+      args.oldContent,
+      args.newContent,
+      reason,
+      args.source,
+      args.createdAt,
+    )
   }
 }
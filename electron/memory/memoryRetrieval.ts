@@ -43,6 +43,25 @@ type Candidate = CandidateRow & {
 
 type MemoryRetrievalEngineOptions = {
   now?: () => number
+  /** 只读连接：候选召回查询走它，避免排在写事务后面；缺省复用写连接 */
+  readDb?: MemoryDatabaseHandle
+}
+
+type VectorLegOutcome = {
+  hits: Array<{ rowid: number; sim: number }>
+  error?: string
+}
+
+// 向量腿提前落地且第 limit 名命中仍不低于该相似度时，视为高置信，跳过 tag/KG 扩展腿
+const VECTOR_CONFIDENT_SIM = 0.62
+
+const POLL_PENDING = Symbol('poll-pending')
+
+/** 近零等待探测：promise 已落地则返回结果，否则在下一个宏任务返回 null（让已排队的微任务先跑完）。 */
+async function pollSettled<T>(promise: Promise<T>): Promise<T | null> {
+  const pending = new Promise<typeof POLL_PENDING>((resolve) => setImmediate(() => resolve(POLL_PENDING)))
+  const result = await Promise.race([promise, pending])
+  return result === POLL_PENDING ? null : (result as T)
 }
 
 function clampInt(value: unknown, fallback: number, min: number, max: number): number {
@@ -233,6 +252,7 @@ export function computeMemoryRetentionScore(
 
 export class MemoryRetrievalEngine {
   private readonly db: MemoryDatabaseHandle
+  private readonly readDb: MemoryDatabaseHandle
   private readonly embeddingClient: Pick<MemoryEmbeddingClient, 'embedTexts'>
   private readonly vectorSearchClient: Pick<MemoryVectorSearchClient, 'search'>
   private readonly getPersona: (personaId: string) => Persona | null
@@ -246,6 +266,7 @@ export class MemoryRetrievalEngine {
     options: MemoryRetrievalEngineOptions = {},
   ) {
     this.db = db
+    this.readDb = options.readDb ?? db
     this.embeddingClient = embeddingClient
     this.vectorSearchClient = vectorSearchClient
     this.getPersona = getPersona
@@ -299,6 +320,40 @@ export class MemoryRetrievalEngine {
       }
     }
 
+    // 并行扇出：向量腿（embedding 网络往返 + worker 线程检索）最慢且不占用本连接，
+    // 先行发射，与下方同步 SQL 各腿重叠执行；聚合评分在最慢一条必需腿落地后进行。
+    const vectorEnabled = memSettings.vectorEnabled ?? false
+    const vectorConfig = vectorEnabled
+      ? resolveMemoryEmbeddingConfig(memSettings, aiSettings, { requireExplicitModel: true })
+      : null
+    let vectorAttempted = false
+    let vectorReason: string | undefined
+    let vectorPromise: Promise<VectorLegOutcome> | null = null
+    if (vectorEnabled && vectorConfig) {
+      vectorAttempted = true
+      vectorPromise = (async (): Promise<VectorLegOutcome> => {
+        try {
+          const queryEmbedding = await this.embeddingClient.embedTexts(vectorConfig, [
+            normalizeText(query).slice(0, 800),
+          ])
+          const hits = await this.vectorSearchClient.search({
+            model: vectorConfig.model,
+            personaId,
+            includeShared,
+            scanLimit: clampInt(memSettings.vectorScanLimit, 2000, 200, 10000),
+            minScore: clampFloat(memSettings.vectorMinScore, 0.35, 0, 1),
+            topK: clampInt(memSettings.vectorTopK, 20, 1, 100),
+            query: queryEmbedding[0].vec,
+          })
+          return { hits }
+        } catch (error) {
+          return { hits: [], error: error instanceof Error ? error.message : String(error) }
+        }
+      })()
+    } else {
+      vectorReason = vectorEnabled ? 'missing_config' : 'disabled'
+    }
+
     const candidates = new Map<number, Candidate>()
     const upsert = (
       row: CandidateRow,
@@ -324,7 +379,7 @@ export class MemoryRetrievalEngine {
     }
 
     const ftsLimit = clampInt(limit * 5, 60, limit, 200)
-    const ftsRows = this.db
+    const ftsRows = this.readDb
       .prepare(
         `
         SELECT
@@ -358,7 +413,7 @@ export class MemoryRetrievalEngine {
     if (ftsRows.length === 0) {
       const keyword = extractKeywordFromQueryForLike(query)
       const needle = (keyword && keyword !== query ? keyword : query).slice(0, 120)
-      const likeRows = this.db
+      const likeRows = this.readDb
         .prepare(
           `
           SELECT
@@ -384,6 +439,18 @@ export class MemoryRetrievalEngine {
       for (const row of likeRows) upsert(row, { likeRel: 0.38 })
     }
 
+    // 向量腿若已落地（如命中 embedding 缓存时）且以高置信度填满 topK，则提前终止：跳过 tag/KG 扩展腿
+    let vectorOutcome: VectorLegOutcome | null = null
+    let vectorEarlyExit = false
+    if (vectorPromise) {
+      vectorOutcome = await pollSettled(vectorPromise)
+      vectorEarlyExit =
+        vectorOutcome !== null &&
+        !vectorOutcome.error &&
+        vectorOutcome.hits.length >= limit &&
+        (vectorOutcome.hits[limit - 1]?.sim ?? 0) >= VECTOR_CONFIDENT_SIM
+    }
+
     const tagEnabled = memSettings.tagEnabled ?? true
     const tagMaxExpand = clampInt(memSettings.tagMaxExpand, 6, 0, 40)
     const baseTagNames = (tagEnabled ? extractMemoryTags(query, { maxTags: 12 }) : [])
@@ -393,9 +460,9 @@ export class MemoryRetrievalEngine {
     let baseTagIds: number[] = []
     let matchedTagCount = 0
 
-    if (tagEnabled && baseTagNames.length > 0) {
+    if (!vectorEarlyExit && tagEnabled && baseTagNames.length > 0) {
       const placeholders = baseTagNames.map(() => '?').join(',')
-      const found = this.db
+      const found = this.readDb
         .prepare(`SELECT id as id, name as name FROM tag WHERE name IN (${placeholders})`)
         .all(...baseTagNames) as Array<{ id: number; name: string }>
       baseTagIds = found.map((row) => clampInt(row.id, 0, 1, 2_000_000_000)).filter((id) => id > 0)
@@ -405,7 +472,7 @@ export class MemoryRetrievalEngine {
       if (baseTagIds.length > 0 && tagMaxExpand > 0) {
         const inA = baseTagIds.map(() => '?').join(',')
         const inB = baseTagIds.map(() => '?').join(',')
-        const related = this.db
+        const related = this.readDb
           .prepare(
             `
             SELECT mt2.tag_id as tagId, COUNT(*) as count
@@ -433,7 +500,7 @@ export class MemoryRetrievalEngine {
       if (allTagIds.length > 0) {
         const inTags = allTagIds.map(() => '?').join(',')
         const tagLimit = clampInt(limit * 8, 120, limit, 600)
-        const tagRows = this.db
+        const tagRows = this.readDb
           .prepare(
             `
             SELECT
@@ -464,8 +531,8 @@ export class MemoryRetrievalEngine {
       }
     }
 
-    if (memSettings.kgEnabled ?? false) {
-      const entityRows = this.db
+    if (!vectorEarlyExit && (memSettings.kgEnabled ?? false)) {
+      const entityRows = this.readDb
         .prepare(
           `
           SELECT e.id as id
@@ -480,7 +547,7 @@ export class MemoryRetrievalEngine {
       if (entityIds.length > 0) {
         const placeholders = entityIds.map(() => '?').join(',')
         const kgLimit = clampInt(limit * 6, 120, limit, 500)
-        const memoryRows = this.db
+        const memoryRows = this.readDb
           .prepare(
             `
             SELECT
@@ -511,61 +578,36 @@ export class MemoryRetrievalEngine {
       }
     }
 
-    const vectorEnabled = memSettings.vectorEnabled ?? false
-    const needVector = vectorEnabled && candidates.size < limit
-    let vectorAttempted = false
-    let vectorReason: string | undefined
-    let vectorError: string | undefined
-    if (needVector) {
-      const config = resolveMemoryEmbeddingConfig(memSettings, aiSettings, { requireExplicitModel: true })
-      if (config) {
-        try {
-          vectorAttempted = true
-          const queryEmbedding = await this.embeddingClient.embedTexts(config, [normalizeText(query).slice(0, 800)])
-          const hits = await this.vectorSearchClient.search({
-            model: config.model,
-            personaId,
-            includeShared,
-            scanLimit: clampInt(memSettings.vectorScanLimit, 2000, 200, 10000),
-            minScore: clampFloat(memSettings.vectorMinScore, 0.35, 0, 1),
-            topK: clampInt(memSettings.vectorTopK, 20, 1, 100),
-            query: queryEmbedding[0].vec,
-          })
-          if (hits.length > 0) {
-            const placeholders = hits.map(() => '?').join(',')
-            const rows = this.db
-              .prepare(
-                `
-                SELECT
-                  rowid as rowid,
-                  role as role,
-                  content as content,
-                  created_at as createdAt,
-                  importance as importance,
-                  strength as strength,
-                  access_count as accessCount,
-                  last_accessed_at as lastAccessedAt,
-                  status as status,
-                  pinned as pinned
-                FROM memory
-                WHERE rowid IN (${placeholders})
-                `,
-              )
-              .all(...hits.map((hit) => hit.rowid)) as CandidateRow[]
-            const byRowid = new Map(rows.map((row) => [row.rowid, row]))
-            for (const hit of hits) {
-              const row = byRowid.get(hit.rowid)
-              if (row) upsert(row, { vecRel: clampFloat(hit.sim, 0, 0, 1) })
-            }
-          }
-        } catch (error) {
-          vectorError = error instanceof Error ? error.message : String(error)
-        }
-      } else {
-        vectorReason = 'missing_config'
+    // 聚合：等待最慢的必需腿（向量）落地，回表补全候选行后统一评分
+    if (vectorPromise && !vectorOutcome) vectorOutcome = await vectorPromise
+    const vectorError = vectorOutcome?.error
+    const vectorHits = vectorOutcome?.hits ?? []
+    if (vectorHits.length > 0) {
+      const placeholders = vectorHits.map(() => '?').join(',')
+      const rows = this.readDb
+        .prepare(
+          `
+          SELECT
+            rowid as rowid,
+            role as role,
+            content as content,
+            created_at as createdAt,
+            importance as importance,
+            strength as strength,
+            access_count as accessCount,
+            last_accessed_at as lastAccessedAt,
+            status as status,
+            pinned as pinned
+          FROM memory
+          WHERE rowid IN (${placeholders})
+          `,
+        )
+        .all(...vectorHits.map((hit) => hit.rowid)) as CandidateRow[]
+      const byRowid = new Map(rows.map((row) => [row.rowid, row]))
+      for (const hit of vectorHits) {
+        const row = byRowid.get(hit.rowid)
+        if (row) upsert(row, { vecRel: clampFloat(hit.sim, 0, 0, 1) })
       }
-    } else {
-      vectorReason = vectorEnabled ? 'candidates_sufficient' : 'disabled'
     }
 
     const finalRanked = Array.from(candidates.values())
@@ -619,6 +661,7 @@ export class MemoryRetrievalEngine {
         vector: {
           enabled: vectorEnabled,
           attempted: vectorAttempted,
+          ...(vectorEarlyExit ? { earlyExit: true } : {}),
           ...(vectorReason ? { reason: vectorReason } : {}),
           ...(vectorError ? { error: vectorError } : {}),
         },
@@ -637,7 +680,7 @@ export class MemoryRetrievalEngine {
     timeRange: TimeRangeParseResult
     vectorEnabled: boolean
   }): MemoryRetrieveResult {
-    const rows = this.db
+    const rows = this.readDb
       .prepare(
         `
         SELECT rowid as rowid, role as role, content as content, created_at as createdAt
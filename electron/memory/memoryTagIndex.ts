@@ -1,5 +1,5 @@
 import type { MemorySettings } from '../types'
-import type { MemoryDatabaseHandle } from './memoryDatabase'
+import { preparedStatement, type MemoryDatabaseHandle } from './memoryDatabase'
 import { MemoryIndexQueue } from './memoryIndexQueue'
 
 export type MemoryTagMaintenanceResult = {
@@ -147,10 +147,14 @@ export class MemoryTagIndexMaintainer {
     if (rows.length === 0) return { scanned: 0, updated: 0 }
 
     const timestamp = this.now()
-    const insertTag = this.db.prepare('INSERT INTO tag(name, created_at) VALUES (?, ?) ON CONFLICT(name) DO NOTHING')
-    const getTag = this.db.prepare('SELECT id as id FROM tag WHERE name = ? LIMIT 1')
-    const clear = this.db.prepare('DELETE FROM memory_tag WHERE memory_rowid = ?')
-    const insertRelation = this.db.prepare(
+    const insertTag = preparedStatement(
+      this.db,
+      'INSERT INTO tag(name, created_at) VALUES (?, ?) ON CONFLICT(name) DO NOTHING',
+    )
+    const getTag = preparedStatement(this.db, 'SELECT id as id FROM tag WHERE name = ? LIMIT 1')
+    const clear = preparedStatement(this.db, 'DELETE FROM memory_tag WHERE memory_rowid = ?')
+    const insertRelation = preparedStatement(
+      this.db,
       'INSERT OR IGNORE INTO memory_tag(memory_rowid, tag_id, created_at) VALUES (?, ?, ?)',
     )
 
@@ -51,7 +51,7 @@ export class MemoryVectorIndexMaintainer {
   async run(
     memSettings: MemorySettings,
     aiSettings: AISettings,
-    options: { batchSize?: number } = {},
+    options: { batchSize?: number; requestBatchSize?: number; concurrency?: number } = {},
   ): Promise<MemoryVectorMaintenanceResult> {
     if ((memSettings.vectorEnabled ?? false) === false) return { scanned: 0, embedded: 0, skipped: 0 }
 
@@ -63,7 +63,7 @@ export class MemoryVectorIndexMaintainer {
       return { scanned: 0, embedded: 0, skipped: 0, error: 'embeddings API 未配置（缺少 apiKey/baseUrl）' }
     }
 
-    const batchSize = clampInt(options.batchSize, 8, 1, 64)
+    const batchSize = clampInt(options.batchSize, 8, 1, 256)
     const pending = this.queue.take('embedding', batchSize)
     const rows: VectorCandidate[] = []
 
@@ -146,42 +146,65 @@ export class MemoryVectorIndexMaintainer {
 
     if (toEmbed.length === 0) return { scanned: rows.length, embedded: 0, skipped: toTouch.length }
 
-    try {
-      const embedded = await this.embeddingClient.embedTexts(
-        config,
-        toEmbed.map((item) => item.text),
-      )
-      const timestamp = this.now()
-      const upsert = this.db.prepare(
-        `
-        INSERT INTO memory_embedding (memory_rowid, model, dims, content_hash, embedding, created_at, updated_at)
-        VALUES (?, ?, ?, ?, ?, ?, ?)
-        ON CONFLICT(memory_rowid) DO UPDATE SET
-          model = excluded.model,
-          dims = excluded.dims,
-          content_hash = excluded.content_hash,
-          embedding = excluded.embedding,
-          updated_at = excluded.updated_at
-        `,
-      )
+    // 待嵌入文本切成若干请求批次并发发送（单请求携带数组），失败批次不拖累已成功批次的落库
+    const requestBatchSize = clampInt(options.requestBatchSize, 16, 1, 64)
+    const concurrency = clampInt(options.concurrency, 2, 1, 8)
+    const chunks: Array<Array<{ rowid: number; text: string; hash: string }>> = []
+    for (let i = 0; i < toEmbed.length; i += requestBatchSize) {
+      chunks.push(toEmbed.slice(i, i + requestBatchSize))
+    }
 
-      const transaction = this.db.transaction(() => {
-        for (let i = 0; i < toEmbed.length; i++) {
-          const item = toEmbed[i]
-          const vec = embedded[i].vec
-          const buffer = Buffer.from(vec.buffer, vec.byteOffset, vec.byteLength)
-          upsert.run(item.rowid, model, vec.length, item.hash, buffer, timestamp, timestamp)
+    const upsert = this.db.prepare(
+      `
+      INSERT INTO memory_embedding (memory_rowid, model, dims, content_hash, embedding, created_at, updated_at)
+      VALUES (?, ?, ?, ?, ?, ?, ?)
+      ON CONFLICT(memory_rowid) DO UPDATE SET
+        model = excluded.model,
+        dims = excluded.dims,
+        content_hash = excluded.content_hash,
+        embedding = excluded.embedding,
+        updated_at = excluded.updated_at
+      `,
+    )
+
+    let embeddedCount = 0
+    let firstError: string | undefined
+    let nextChunk = 0
+    const drainChunks = async (): Promise<void> => {
+      while (true) {
+        const chunkIndex = nextChunk++
+        if (chunkIndex >= chunks.length) return
+        const chunk = chunks[chunkIndex]
+        try {
+          const embedded = await this.embeddingClient.embedTexts(
+            config,
+            chunk.map((item) => item.text),
+          )
+          const timestamp = this.now()
+          const transaction = this.db.transaction(() => {
+            for (let i = 0; i < chunk.length; i++) {
+              const item = chunk[i]
+              const vec = embedded[i].vec
+              const buffer = Buffer.from(vec.buffer, vec.byteOffset, vec.byteLength)
+              upsert.run(item.rowid, model, vec.length, item.hash, buffer, timestamp, timestamp)
+            }
+          })
+          transaction()
+          embeddedCount += chunk.length
+        } catch (error) {
+          firstError ??= error instanceof Error ? error.message : String(error)
         }
-      })
-      transaction()
-      return { scanned: rows.length, embedded: toEmbed.length, skipped: toTouch.length }
-    } catch (error) {
-      return {
-        scanned: rows.length,
-        embedded: 0,
-        skipped: toTouch.length,
-        error: error instanceof Error ? error.message : String(error),
       }
     }
+    await Promise.all(
+      Array.from({ length: Math.min(concurrency, chunks.length) }, () => drainChunks()),
+    )
+
+    return {
+      scanned: rows.length,
+      embedded: embeddedCount,
+      skipped: toTouch.length,
+      ...(firstError ? { error: firstError } : {}),
+    }
   }
 }
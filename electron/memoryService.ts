@@ -1,5 +1,6 @@
 import { MemoryCatalog } from './memory/memoryCatalog'
 import { openMemoryDatabase, type MemoryDatabaseHandle } from './memory/memoryDatabase'
+import { MemoryEmbeddingCacheStore } from './memory/memoryEmbeddingCache'
 import { MemoryEmbeddingClient } from './memory/memoryEmbeddingClient'
 import { MemoryIndexQueue } from './memory/memoryIndexQueue'
 import { MemoryKgIndexMaintainer } from './memory/memoryKgIndex'
@@ -11,6 +12,7 @@ import { MemoryRevisionCoordinator } from './memory/memoryRevisionCoordinator'
 import { MemoryTagIndexMaintainer } from './memory/memoryTagIndex'
 import { MemoryVectorIndexMaintainer } from './memory/memoryVectorIndex'
 import { MemoryVectorSearchClient } from './memory/memoryVectorSearchClient'
+import { startSpan } from './tracing'
 import {
   MemoryWriteCoordinator,
   type MemoryIngestChatMessageArgs,
@@ -46,9 +48,10 @@ export type { MemoryIngestChatMessageArgs } from './memory/memoryWriteCoordinato
 
 export class MemoryService {
   private db: MemoryDatabaseHandle
+  private readDb: MemoryDatabaseHandle
   private catalog: MemoryCatalog
   private indexQueue = new MemoryIndexQueue()
-  private embeddingClient = new MemoryEmbeddingClient()
+  private embeddingClient: MemoryEmbeddingClient
   private kgIndexMaintainer: MemoryKgIndexMaintainer
   private personaStore: MemoryPersonaStore
   private recordStore: MemoryRecordStore
@@ -63,6 +66,10 @@ export class MemoryService {
   constructor(userDataDir: string) {
     const opened = openMemoryDatabase(userDataDir)
     this.db = opened.db
+    this.readDb = opened.readDb
+    this.embeddingClient = new MemoryEmbeddingClient({
+      persistentCache: new MemoryEmbeddingCacheStore(opened.db),
+    })
     this.catalog = new MemoryCatalog(opened.db)
     this.kgIndexMaintainer = new MemoryKgIndexMaintainer(opened.db, this.indexQueue)
     this.personaStore = new MemoryPersonaStore(opened.db)
@@ -77,6 +84,7 @@ export class MemoryService {
       this.embeddingClient,
       this.vectorSearchClient,
       (personaId) => this.getPersona(personaId),
+      { readDb: opened.readDb },
     )
     this.writeCoordinator = new MemoryWriteCoordinator(
       opened.db,
@@ -89,6 +97,7 @@ export class MemoryService {
 
   close(): void {
     this.vectorSearchClient.close()
+    this.readDb.close()
     this.db.close()
   }
 
@@ -122,7 +131,12 @@ export class MemoryService {
     memSettings: MemorySettings | undefined,
     aiSettings: AISettings,
   ): Promise<void> {
-    return this.writeCoordinator.ingestChatMessage(args, memSettings, aiSettings)
+    const endSpan = startSpan('memory', 'ingestChatMessage')
+    try {
+      return await this.writeCoordinator.ingestChatMessage(args, memSettings, aiSettings)
+    } finally {
+      endSpan()
+    }
   }
 
   runTagMaintenance(settings: MemorySettings, opts?: { batchSize?: number }): { scanned: number; updated: number } {
@@ -214,7 +228,12 @@ export class MemoryService {
     memSettings: MemorySettings,
     aiSettings: AISettings,
   ): Promise<MemoryRetrieveResult> {
-    return this.retrievalEngine.retrieve(args, memSettings, aiSettings)
+    const endSpan = startSpan('memory', 'retrieveContext')
+    try {
+      return await this.retrievalEngine.retrieve(args, memSettings, aiSettings)
+    } finally {
+      endSpan()
+    }
   }
 
 }
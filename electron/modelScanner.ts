@@ -26,6 +26,60 @@ function getLive2dDir(): string {
   }
 }
 
+// 扫描结果持久缓存：以模型文件夹绝对路径 + 目录 mtime 为键。findModelFile 只依赖
+// 文件夹内的文件名列表，而目录 mtime 恰好在增删/改名时变化，所以 mtime 未变的文件夹
+// 可以跳过逐目录 readdir，直接复用上次选中的模型文件名。
+type ScanCacheEntry = {
+  mtimeMs: number
+  modelFileName: string | null
+}
+
+type ScanCacheFile = {
+  version: 1
+  entries: Record<string, ScanCacheEntry>
+}
+
+const SCAN_CACHE_FILE_NAME = 'live2d-scan-cache.json'
+
+let scanCacheEntries: Record<string, ScanCacheEntry> | null = null
+
+function getScanCachePath(): string | null {
+  try {
+    return path.join(app.getPath('userData'), SCAN_CACHE_FILE_NAME)
+  } catch {
+    return null
+  }
+}
+
+function loadScanCache(): Record<string, ScanCacheEntry> {
+  if (scanCacheEntries) return scanCacheEntries
+  scanCacheEntries = {}
+  const cachePath = getScanCachePath()
+  if (!cachePath) return scanCacheEntries
+  try {
+    const parsed = JSON.parse(fs.readFileSync(cachePath, 'utf-8')) as ScanCacheFile
+    if (parsed && parsed.version === 1 && parsed.entries && typeof parsed.entries === 'object') {
+      scanCacheEntries = parsed.entries
+    }
+  } catch {
+    // 缓存损坏或不存在都按空缓存处理，重新全量扫描即可
+  }
+  return scanCacheEntries
+}
+
+function persistScanCache(entries: Record<string, ScanCacheEntry>): void {
+  const cachePath = getScanCachePath()
+  if (!cachePath) return
+  try {
+    const payload: ScanCacheFile = { version: 1, entries }
+    const temporaryPath = `${cachePath}.${process.pid}.tmp`
+    fs.writeFileSync(temporaryPath, JSON.stringify(payload), 'utf-8')
+    fs.renameSync(temporaryPath, cachePath)
+  } catch {
+    // Silently fail
+  }
+}
+
 /**
  * Find model file in a directory
  * Looks for .model3.json or .model.json files
@@ -65,13 +119,32 @@ export function scanLive2dModels(): ScannedModel[] {
     }
 
     const entries = fs.readdirSync(live2dDir, { withFileTypes: true })
+    const cache = loadScanCache()
+    const nextCache: Record<string, ScanCacheEntry> = {}
+    let cacheDirty = false
 
     for (const entry of entries) {
       if (!entry.isDirectory()) continue
 
       const folderName = entry.name
       const folderPath = path.join(live2dDir, folderName)
-      const modelFileName = findModelFile(folderPath)
+
+      let mtimeMs = 0
+      try {
+        mtimeMs = fs.statSync(folderPath).mtimeMs
+      } catch {
+        continue
+      }
+
+      const cached = cache[folderPath]
+      let modelFileName: string | null
+      if (cached && cached.mtimeMs === mtimeMs) {
+        modelFileName = cached.modelFileName
+      } else {
+        modelFileName = findModelFile(folderPath)
+        cacheDirty = true
+      }
+      nextCache[folderPath] = { mtimeMs, modelFileName }
 
       if (modelFileName) {
         const model: ScannedModel = {
@@ -84,6 +157,14 @@ export function scanLive2dModels(): ScannedModel[] {
         models.push(model)
       }
     }
+
+    // 有文件夹新增/变化，或有文件夹被移除时才回写缓存文件
+    if (cacheDirty || Object.keys(nextCache).length !== Object.keys(cache).length) {
+      scanCacheEntries = nextCache
+      persistScanCache(nextCache)
+    } else {
+      scanCacheEntries = nextCache
+    }
   } catch {
     // Silently fail
   }
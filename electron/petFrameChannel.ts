@@ -0,0 +1,117 @@
+// 宠物窗口高频帧通道：主进程的鼠标跟踪泵（33ms）和穿透探针泵（80ms）原先各自
+// 以结构化克隆对象逐条发送，说话+动画时两路叠加每秒几十条消息。这里把它们合并
+// 成一条二进制帧通道（'pet:frame'）：生产方只记"每个字段的最新值"，按帧窗口
+// （16ms，约一个动画帧）最多冲刷一次，一条 Float64Array 载荷携带所有待发字段。
+// 线上布局由下面的字段表推导（首个 double 是存在位掩码，其后按表序排列各字段
+// 分量），preload 侧按同一张表解码回原有的类型化监听器，调用点无需改动。
+
+/** 字段表：名称 → 分量数。新增字段追加在表尾即可，位掩码与布局随表推导。 */
+export const PET_FRAME_FIELDS = {
+  mouseTarget: 3, // x, y, t
+  cursorProbe: 2, // x, y
+} as const
+
+export type PetFrameFieldName = keyof typeof PET_FRAME_FIELDS
+
+export type PetFramePayload = {
+  mouseTarget?: { x: number; y: number; t: number }
+  cursorProbe?: { x: number; y: number }
+}
+
+const FIELD_ORDER = Object.keys(PET_FRAME_FIELDS) as PetFrameFieldName[]
+const FRAME_DOUBLES = 1 + FIELD_ORDER.reduce((sum, name) => sum + PET_FRAME_FIELDS[name], 0)
+const PET_FRAME_FLUSH_INTERVAL_MS = 16
+
+function fieldValues(name: PetFrameFieldName, payload: PetFramePayload): number[] | null {
+  if (name === 'mouseTarget') {
+    const target = payload.mouseTarget
+    return target ? [target.x, target.y, target.t] : null
+  }
+  const probe = payload.cursorProbe
+  return probe ? [probe.x, probe.y] : null
+}
+
+export function encodePetFrame(payload: PetFramePayload): Uint8Array {
+  const doubles = new Float64Array(FRAME_DOUBLES)
+  let mask = 0
+  let offset = 1
+  for (let i = 0; i < FIELD_ORDER.length; i++) {
+    const name = FIELD_ORDER[i]
+    const values = fieldValues(name, payload)
+    if (values) {
+      mask |= 1 << i
+      doubles.set(values, offset)
+    }
+    offset += PET_FRAME_FIELDS[name]
+  }
+  doubles[0] = mask
+  return new Uint8Array(doubles.buffer)
+}
+
+export function decodePetFrame(frame: ArrayBufferView | ArrayBuffer): PetFramePayload {
+  const view =
+    frame instanceof ArrayBuffer
+      ? new Float64Array(frame)
+      : new Float64Array(frame.buffer, frame.byteOffset, Math.floor(frame.byteLength / 8))
+  if (view.length < FRAME_DOUBLES) return {}
+  const mask = view[0]
+  const payload: PetFramePayload = {}
+  let offset = 1
+  for (let i = 0; i < FIELD_ORDER.length; i++) {
+    const name = FIELD_ORDER[i]
+    if (mask & (1 << i)) {
+      if (name === 'mouseTarget') payload.mouseTarget = { x: view[offset], y: view[offset + 1], t: view[offset + 2] }
+      else payload.cursorProbe = { x: view[offset], y: view[offset + 1] }
+    }
+    offset += PET_FRAME_FIELDS[name]
+  }
+  return payload
+}
+
+export type PetFrameBatcher = {
+  /** 记录字段最新值并安排帧冲刷；同一帧窗口内的重复写入只保留最后一次。 */
+  set: (payload: PetFramePayload) => void
+  /** 立即冲刷待发字段（退出/销毁前调用）。 */
+  flush: () => void
+  close: () => void
+}
+
+export function createPetFrameBatcher(
+  send: (frame: Uint8Array) => void,
+  flushIntervalMs: number = PET_FRAME_FLUSH_INTERVAL_MS,
+): PetFrameBatcher {
+  let pending: PetFramePayload = {}
+  let hasPending = false
+  let timer: ReturnType<typeof setTimeout> | null = null
+  let closed = false
+
+  const flush = () => {
+    if (timer) {
+      clearTimeout(timer)
+      timer = null
+    }
+    if (!hasPending || closed) return
+    const payload = pending
+    pending = {}
+    hasPending = false
+    send(encodePetFrame(payload))
+  }
+
+  return {
+    set: (payload) => {
+      if (closed) return
+      if (payload.mouseTarget) pending.mouseTarget = payload.mouseTarget
+      if (payload.cursorProbe) pending.cursorProbe = payload.cursorProbe
+      hasPending = hasPending || Boolean(payload.mouseTarget || payload.cursorProbe)
+      if (!timer && hasPending) {
+        timer = setTimeout(flush, flushIntervalMs)
+        ;(timer as unknown as { unref?: () => void }).unref?.()
+      }
+    },
+    flush,
+    close: () => {
+      flush()
+      closed = true
+    },
+  }
+}
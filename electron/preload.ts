@@ -61,6 +61,8 @@ import type {
   SettingsNavigationTarget,
 } from './types'
 import type { TtsOptions } from './ttsOptions'
+import type { TraceSnapshot } from './tracing'
+import { decodePetFrame } from './petFrameChannel'
 import { parsePreloadWindowType, pickPreloadApi } from './preloadPermissions'
 
 export type SettingsChangeListener = (settings: AppSettings) => void
@@ -92,6 +94,13 @@ const neoDeskPetApi = {
     ipcRenderer.send('debug:append', { event, data })
   },
 
+  // 追踪面板：IPC/工具/记忆 span 分位数快照与 Chrome trace 导出；渲染进程卡顿上报
+  getTraceSnapshot: (): Promise<TraceSnapshot> => ipcRenderer.invoke('trace:getSnapshot'),
+  exportTrace: (): Promise<string> => ipcRenderer.invoke('trace:export'),
+  reportEventLoopLag: (lagMs: number): void => {
+    ipcRenderer.send('trace:reportLag', lagMs)
+  },
+
   getSettings: (): Promise<AppSettings> => ipcRenderer.invoke('settings:get'),
   setSecret: (target: SettingsSecretTarget, value: string): Promise<{ ok: true; hasValue: boolean }> =>
     ipcRenderer.invoke('settings:setSecret', target, value),
@@ -379,10 +388,15 @@ const neoDeskPetApi = {
   },
 
   // Live2D mouse tracking target (main -> pet window)
+  // 'pet:frame' 二进制帧通道：主进程把鼠标跟踪目标与穿透探针坐标按帧合并成一条
+  // Float64Array 消息；这里按字段表解码回原有的类型化监听器，调用点无需改动
   onLive2dMouseTarget: (listener: Live2DMouseTargetListener): (() => void) => {
-    const handler = (_event: Electron.IpcRendererEvent, payload: { x: number; y: number; t?: number }) => listener(payload)
-    ipcRenderer.on('live2d:mouseTarget', handler)
-    return () => ipcRenderer.off('live2d:mouseTarget', handler)
+    const handler = (_event: Electron.IpcRendererEvent, frame: Uint8Array) => {
+      const payload = decodePetFrame(frame)
+      if (payload.mouseTarget) listener(payload.mouseTarget)
+    }
+    ipcRenderer.on('pet:frame', handler)
+    return () => ipcRenderer.off('pet:frame', handler)
   },
   // Live2D capabilities report (pet window -> main)
   reportLive2dCapabilities: (payload: unknown): void => {
@@ -421,9 +435,12 @@ const neoDeskPetApi = {
   setPetOverlayHover: (hovering: boolean): void => ipcRenderer.send('pet:setOverlayHover', hovering),
   setPetModelHover: (hovering: boolean): void => ipcRenderer.send('pet:setModelHover', hovering),
   onPetCursorProbe: (listener: (payload: { x: number; y: number }) => void): (() => void) => {
-    const handler = (_event: Electron.IpcRendererEvent, payload: { x: number; y: number }) => listener(payload)
-    ipcRenderer.on('pet:cursorProbe', handler)
-    return () => ipcRenderer.off('pet:cursorProbe', handler)
+    const handler = (_event: Electron.IpcRendererEvent, frame: Uint8Array) => {
+      const payload = decodePetFrame(frame)
+      if (payload.cursorProbe) listener(payload.cursorProbe)
+    }
+    ipcRenderer.on('pet:frame', handler)
+    return () => ipcRenderer.off('pet:frame', handler)
   },
 
   // Mouse forward for transparent click-through
@@ -1,6 +1,6 @@
 import type { WindowType } from './types'
 
-const COMMON_METHODS = ['getSettings', 'onSettingsChanged'] as const
+const COMMON_METHODS = ['getSettings', 'onSettingsChanged', 'reportEventLoopLag'] as const
 
 export const PRELOAD_API_METHODS: Record<WindowType, readonly string[]> = {
   pet: [
@@ -203,6 +203,8 @@ export const PRELOAD_API_METHODS: Record<WindowType, readonly string[]> = {
     'deleteMemory',
     'deleteManyMemory',
     'deleteMemoryByFilter',
+    'getTraceSnapshot',
+    'exportTrace',
     'openSettings',
     'closeCurrent',
   ],
@@ -170,6 +170,264 @@ async function runPowerShell(script: string, timeoutMs: number, signal?: AbortSi
   })
 }
 
+// —— 常驻截图会话 ——
+// 每次截图都冷启动 PowerShell（进程启动 + Add-Type 编译 DpiAwareness）要 1.5~3s，
+// 任务代理的“看屏幕”循环因此非常慢。这里维护一个长驻 helper 进程：prelude 只编译
+// 一次，之后通过 stdin/stdout 的行式 JSON 协议服务 snapshot/capture 请求（热路径
+// 低于 100ms）。空闲一段时间后自动退出释放资源，下次请求再拉起；会话异常时调用方
+// 回退到原有的一次性 runPowerShell 路径。
+
+const CAPTURE_SESSION_IDLE_MS = 30_000
+
+function captureSessionHelperPs(): string {
+  return `
+${dpiAwarePreludePs()}
+Add-Type -AssemblyName System.Windows.Forms
+Add-Type -AssemblyName System.Drawing
+$stdout = [Console]::Out
+$stdout.WriteLine('{"ready":true}')
+while ($true) {
+  $line = [Console]::In.ReadLine()
+  if ($null -eq $line) { break }
+  if (-not $line.Trim()) { continue }
+  $id = 0
+  try {
+    $req = $line | ConvertFrom-Json
+    $id = [int]$req.id
+    if ($req.op -eq 'snapshot') {
+      $items = @([System.Windows.Forms.Screen]::AllScreens | ForEach-Object {
+        [pscustomobject]@{
+          deviceName = $_.DeviceName
+          primary = $_.Primary
+          x = $_.Bounds.X
+          y = $_.Bounds.Y
+          width = $_.Bounds.Width
+          height = $_.Bounds.Height
+        }
+      })
+      $cursor = [System.Windows.Forms.Cursor]::Position
+      $result = [pscustomobject]@{
+        displays = $items
+        cursor = [pscustomobject]@{ x = $cursor.X; y = $cursor.Y }
+      }
+      $stdout.WriteLine(([pscustomobject]@{ id = $id; ok = $true; result = $result } | ConvertTo-Json -Depth 8 -Compress))
+    } elseif ($req.op -eq 'capture') {
+      $bmp = New-Object System.Drawing.Bitmap ([int]$req.w), ([int]$req.h), ([System.Drawing.Imaging.PixelFormat]::Format32bppArgb)
+      $g = [System.Drawing.Graphics]::FromImage($bmp)
+      try {
+        $g.CopyFromScreen([int]$req.x, [int]$req.y, 0, 0, $bmp.Size)
+        $bmp.Save([string]$req.out, [System.Drawing.Imaging.ImageFormat]::Png)
+      } finally {
+        $g.Dispose()
+        $bmp.Dispose()
+      }
+      $stdout.WriteLine(([pscustomobject]@{ id = $id; ok = $true } | ConvertTo-Json -Compress))
+    } else {
+      $stdout.WriteLine(([pscustomobject]@{ id = $id; ok = $false; error = 'unknown op' } | ConvertTo-Json -Compress))
+    }
+  } catch {
+    $stdout.WriteLine(([pscustomobject]@{ id = $id; ok = $false; error = $_.Exception.Message } | ConvertTo-Json -Compress))
+  }
+}
+`.trim()
+}
+
+/** 测试注入用的最小子进程接口（真实实现为 spawn 出的 powershell.exe） */
+export type ScreenCaptureHelperProcess = {
+  pid?: number
+  stdin?: { write(chunk: string): unknown } | null
+  stdout?: { on(event: 'data', listener: (chunk: Buffer | string) => void): unknown } | null
+  once(event: 'error' | 'close', listener: (...args: unknown[]) => void): unknown
+}
+
+type PendingCaptureRequest = {
+  resolve: (result: Record<string, unknown> | undefined) => void
+  reject: (err: Error) => void
+  timer: ReturnType<typeof setTimeout>
+  cleanup: () => void
+}
+
+export class ScreenCaptureSession {
+  private child: ScreenCaptureHelperProcess | null = null
+  private nextId = 1
+  private pending = new Map<number, PendingCaptureRequest>()
+  private stdoutBuffer = ''
+  private idleTimer: ReturnType<typeof setTimeout> | null = null
+  private readonly idleTimeoutMs: number
+  private readonly spawnHelper: () => ScreenCaptureHelperProcess
+
+  constructor(options?: { spawnHelper?: () => ScreenCaptureHelperProcess; idleTimeoutMs?: number }) {
+    this.idleTimeoutMs = Math.max(1000, options?.idleTimeoutMs ?? CAPTURE_SESSION_IDLE_MS)
+    this.spawnHelper =
+      options?.spawnHelper ??
+      (() => {
+        if (process.platform !== 'win32') {
+          throw new Error('screen.capture 目前仅支持 Windows 内置截图')
+        }
+        const encoded = encodePowerShell(captureSessionHelperPs())
+        return spawn(
+          'powershell.exe',
+          ['-NoProfile', '-NonInteractive', '-ExecutionPolicy', 'Bypass', '-EncodedCommand', encoded],
+          { windowsHide: true },
+        )
+      })
+  }
+
+  isRunning(): boolean {
+    return this.child !== null
+  }
+
+  private ensureChild(): ScreenCaptureHelperProcess {
+    if (this.child) return this.child
+    const child = this.spawnHelper()
+    this.child = child
+    this.stdoutBuffer = ''
+    child.stdout?.on('data', (chunk) => {
+      if (this.child !== child) return
+      this.handleStdout(Buffer.isBuffer(chunk) ? chunk.toString('utf8') : String(chunk ?? ''))
+    })
+    child.once('error', (err) => {
+      if (this.child !== child) return
+      this.handleLoss(err instanceof Error ? err : new Error(String(err)))
+    })
+    child.once('close', () => {
+      if (this.child !== child) return
+      this.handleLoss(new Error('screen.capture 会话进程已退出'))
+    })
+    return child
+  }
+
+  private handleStdout(text: string): void {
+    this.stdoutBuffer += text
+    for (;;) {
+      const nl = this.stdoutBuffer.indexOf('\n')
+      if (nl < 0) break
+      const line = this.stdoutBuffer.slice(0, nl).trim()
+      this.stdoutBuffer = this.stdoutBuffer.slice(nl + 1)
+      if (!line) continue
+
+      let parsed: Record<string, unknown>
+      try {
+        parsed = JSON.parse(line) as Record<string, unknown>
+      } catch {
+        continue
+      }
+      if (parsed.ready === true) continue
+
+      const id = Number(parsed.id)
+      const entry = this.pending.get(id)
+      if (!entry) continue
+      this.pending.delete(id)
+      entry.cleanup()
+      if (parsed.ok === true) {
+        entry.resolve(
+          parsed.result && typeof parsed.result === 'object' && !Array.isArray(parsed.result)
+            ? (parsed.result as Record<string, unknown>)
+            : undefined,
+        )
+      } else {
+        entry.reject(new Error(String(parsed.error ?? 'screen.capture 会话请求失败')))
+      }
+    }
+    this.touchIdle()
+  }
+
+  /** 会话进程异常/退出：让所有在途请求失败，下次 request 时重新拉起 */
+  private handleLoss(err: Error): void {
+    const child = this.child
+    this.child = null
+    this.stdoutBuffer = ''
+    this.clearIdleTimer()
+    const entries = Array.from(this.pending.values())
+    this.pending.clear()
+    for (const entry of entries) {
+      entry.cleanup()
+      entry.reject(err)
+    }
+    if (child?.pid) void killProcessTree(child.pid)
+  }
+
+  private clearIdleTimer(): void {
+    if (this.idleTimer) {
+      clearTimeout(this.idleTimer)
+      this.idleTimer = null
+    }
+  }
+
+  private touchIdle(): void {
+    this.clearIdleTimer()
+    const timer = setTimeout(() => {
+      this.idleTimer = null
+      if (this.pending.size === 0) this.dispose()
+      else this.touchIdle()
+    }, this.idleTimeoutMs)
+    timer.unref?.()
+    this.idleTimer = timer
+  }
+
+  async request(
+    op: 'snapshot' | 'capture',
+    payload: Record<string, unknown>,
+    opts?: { timeoutMs?: number; signal?: AbortSignal },
+  ): Promise<Record<string, unknown> | undefined> {
+    if (opts?.signal?.aborted) throw new Error('screen.capture canceled')
+    const child = this.ensureChild()
+    const id = this.nextId++
+    const timeoutMs = Math.max(1, opts?.timeoutMs ?? 10_000)
+
+    return await new Promise<Record<string, unknown> | undefined>((resolve, reject) => {
+      const onAbort = () => {
+        // 中止时无法打断 helper 里进行中的 CopyFromScreen，干脆整个会话重建
+        this.pending.delete(id)
+        cleanup()
+        this.handleLoss(new Error('screen.capture canceled'))
+        reject(new Error('screen.capture canceled'))
+      }
+      const timer = setTimeout(() => {
+        // 超时说明 helper 可能已挂起，重建会话避免后续请求排队等死
+        this.pending.delete(id)
+        cleanup()
+        this.handleLoss(new Error(`screen.capture timeout (${timeoutMs}ms)`))
+        reject(new Error(`screen.capture timeout (${timeoutMs}ms)`))
+      }, timeoutMs)
+      timer.unref?.()
+
+      const cleanup = () => {
+        clearTimeout(timer)
+        opts?.signal?.removeEventListener('abort', onAbort)
+      }
+      opts?.signal?.addEventListener('abort', onAbort, { once: true })
+      this.pending.set(id, { resolve, reject, timer, cleanup })
+
+      try {
+        child.stdin?.write(`${JSON.stringify({ id, op, ...payload })}\n`)
+      } catch (err) {
+        this.pending.delete(id)
+        cleanup()
+        this.handleLoss(err instanceof Error ? err : new Error(String(err)))
+        reject(err instanceof Error ? err : new Error(String(err)))
+        return
+      }
+      this.touchIdle()
+    })
+  }
+
+  dispose(): void {
+    this.handleLoss(new Error('screen.capture 会话已关闭'))
+  }
+}
+
+let captureSession: ScreenCaptureSession | null = null
+
+function sessionFor(): ScreenCaptureSession {
+  if (!captureSession) captureSession = new ScreenCaptureSession()
+  return captureSession
+}
+
+export function disposeScreenCaptureSession(): void {
+  captureSession?.dispose()
+}
+
 function nowLocalIso(): string {
   const d = new Date()
   const pad2 = (n: number) => String(n).padStart(2, '0')
@@ -184,7 +442,31 @@ function nowLocalIso(): string {
   )
 }
 
-async function readScreenSnapshot(timeoutMs: number, signal?: AbortSignal): Promise<ScreenSnapshot> {
+function parseScreenSnapshot(parsed: Record<string, unknown>): ScreenSnapshot {
+  const displaysRaw = Array.isArray(parsed.displays) ? parsed.displays : []
+  const displays = displaysRaw
+    .map((m, index) => {
+      const obj = m && typeof m === 'object' && !Array.isArray(m) ? (m as Record<string, unknown>) : null
+      return {
+        deviceName: String(obj?.deviceName ?? ''),
+        index,
+        primary: Boolean(obj?.primary),
+        x: Number(obj?.x ?? 0),
+        y: Number(obj?.y ?? 0),
+        width: Number(obj?.width ?? 0),
+        height: Number(obj?.height ?? 0),
+      }
+    })
+    .filter((d) => d.deviceName && Number.isFinite(d.x) && Number.isFinite(d.y) && d.width > 0 && d.height > 0)
+
+  const cursorObj = parsed.cursor && typeof parsed.cursor === 'object' && !Array.isArray(parsed.cursor) ? (parsed.cursor as Record<string, unknown>) : null
+  const cursor = { x: Number(cursorObj?.x ?? 0), y: Number(cursorObj?.y ?? 0) }
+
+  if (displays.length === 0) throw new Error('screen.capture 未找到显示器')
+  return { displays, cursor }
+}
+
+async function readScreenSnapshotOneShot(timeoutMs: number, signal?: AbortSignal): Promise<ScreenSnapshot> {
   const script = `
 ${dpiAwarePreludePs()}
 Add-Type -AssemblyName System.Windows.Forms
@@ -206,28 +488,18 @@ $cursor = [System.Windows.Forms.Cursor]::Position
 `.trim()
 
   const { stdout } = await runPowerShell(script, timeoutMs, signal)
-  const parsed = JSON.parse(stdout.trim()) as Record<string, unknown>
-  const displaysRaw = Array.isArray(parsed.displays) ? parsed.displays : []
-  const displays = displaysRaw
-    .map((m, index) => {
-      const obj = m && typeof m === 'object' && !Array.isArray(m) ? (m as Record<string, unknown>) : null
-      return {
-        deviceName: String(obj?.deviceName ?? ''),
-        index,
-        primary: Boolean(obj?.primary),
-        x: Number(obj?.x ?? 0),
-        y: Number(obj?.y ?? 0),
-        width: Number(obj?.width ?? 0),
-        height: Number(obj?.height ?? 0),
-      }
-    })
-    .filter((d) => d.deviceName && Number.isFinite(d.x) && Number.isFinite(d.y) && d.width > 0 && d.height > 0)
-
-  const cursorObj = parsed.cursor && typeof parsed.cursor === 'object' && !Array.isArray(parsed.cursor) ? (parsed.cursor as Record<string, unknown>) : null
-  const cursor = { x: Number(cursorObj?.x ?? 0), y: Number(cursorObj?.y ?? 0) }
+  return parseScreenSnapshot(JSON.parse(stdout.trim()) as Record<string, unknown>)
+}
 
-  if (displays.length === 0) throw new Error('screen.capture 未找到显示器')
-  return { displays, cursor }
+async function readScreenSnapshot(timeoutMs: number, signal?: AbortSignal): Promise<ScreenSnapshot> {
+  try {
+    const result = await sessionFor().request('snapshot', {}, { timeoutMs, signal })
+    return parseScreenSnapshot(result ?? {})
+  } catch (err) {
+    if (signal?.aborted) throw err
+    // 会话路径失败（首次拉起失败/进程被杀等）回退到一次性 PowerShell
+    return readScreenSnapshotOneShot(timeoutMs, signal)
+  }
 }
 
 function containsPoint(rect: ScreenRect, point: ScreenPoint): boolean {
@@ -327,8 +599,7 @@ export async function resolveScreenCaptureOutputPath(opts: ScreenCaptureOptions)
   return path.join(realParent, path.basename(target))
 }
 
-async function captureRectToPng(rect: ScreenRect, outPath: string, timeoutMs: number, signal?: AbortSignal): Promise<void> {
-  await fs.mkdir(path.dirname(outPath), { recursive: true })
+async function captureRectToPngOneShot(rect: ScreenRect, outPath: string, timeoutMs: number, signal?: AbortSignal): Promise<void> {
   const script = `
 ${dpiAwarePreludePs()}
 Add-Type -AssemblyName System.Windows.Forms
@@ -352,6 +623,26 @@ try {
   await runPowerShell(script, timeoutMs, signal)
 }
 
+async function captureRectToPng(rect: ScreenRect, outPath: string, timeoutMs: number, signal?: AbortSignal): Promise<void> {
+  await fs.mkdir(path.dirname(outPath), { recursive: true })
+  try {
+    await sessionFor().request(
+      'capture',
+      {
+        x: Math.trunc(rect.x),
+        y: Math.trunc(rect.y),
+        w: Math.trunc(rect.width),
+        h: Math.trunc(rect.height),
+        out: outPath,
+      },
+      { timeoutMs, signal },
+    )
+  } catch (err) {
+    if (signal?.aborted) throw err
+    await captureRectToPngOneShot(rect, outPath, timeoutMs, signal)
+  }
+}
+
 export async function captureScreenToFile(opts: ScreenCaptureOptions): Promise<ScreenCaptureResult> {
   const timeoutMs = Math.max(1000, Math.min(120000, clampInt(opts.timeoutMs, 30000)))
   const snapshot = await readScreenSnapshot(Math.min(timeoutMs, 15000), opts.signal)
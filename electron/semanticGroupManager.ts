@@ -39,10 +39,21 @@ function clampInt(value: unknown, fallback: number, min: number, max: number): n
 
 export type GetEmbeddingFn = (text: string) => Promise<number[] | null>
 
+/** 词元变更后延迟多久增量重算脏组向量（期间的连续编辑合并为一次重算） */
+export const STALE_REFRESH_DELAY_MS = 5_000
+
 export class SemanticGroupManager {
   private db: DatabaseHandle
   private vectorCache = new Map<string, { vec: Float32Array; model: string }>()
   private getEmbedding: GetEmbeddingFn
+  // 组列表/匹配词缓存：激活检测每次聊天都会调用，不应反复回表 + JSON.parse
+  private groupListCache: SemanticGroup[] | null = null
+  private matcherCache = new Map<string, { all: string[]; lowered: string[] }>()
+  // 脏组集合：词元变更后只增量重算这些组的向量，全量重建留给后台任务
+  private staleGroups = new Set<string>()
+  // 最近一次预计算使用的模型；脏组自动重算沿用它，没有就排队等首次全量重建
+  private lastVectorModel: string | null = null
+  private staleRefreshTimer: ReturnType<typeof setTimeout> | null = null
 
   constructor(db: DatabaseHandle, getEmbedding: GetEmbeddingFn) {
     this.db = db
@@ -50,6 +61,35 @@ export class SemanticGroupManager {
     this.initTables()
   }
 
+  private invalidateGroupCache(name?: string): void {
+    this.groupListCache = null
+    if (name) this.matcherCache.delete(name)
+    else this.matcherCache.clear()
+  }
+
+  private markGroupStale(name: string): void {
+    const trimmed = name.trim()
+    if (!trimmed) return
+    this.staleGroups.add(trimmed)
+    this.scheduleStaleRefresh()
+  }
+
+  /**
+   * 延迟触发脏组增量重算：编辑词元通常是连续操作，合并到一个窗口里只重算一次。
+   * 没有已知模型时不排计时器，脏组留给首次全量预计算一并处理。
+   */
+  private scheduleStaleRefresh(): void {
+    if (this.staleRefreshTimer || !this.lastVectorModel) return
+    this.staleRefreshTimer = setTimeout(() => {
+      this.staleRefreshTimer = null
+      if (this.staleGroups.size === 0) return
+      void this.refreshStaleGroupVectors().catch((err) => {
+        console.error('[SemanticGroup] 脏组增量重算失败:', err)
+      })
+    }, STALE_REFRESH_DELAY_MS)
+    ;(this.staleRefreshTimer as unknown as { unref?: () => void }).unref?.()
+  }
+
   /**
    * 更新 embedding 函数（用于配置变更时刷新）
    */
@@ -115,13 +155,21 @@ export class SemanticGroupManager {
     const activations: SemanticGroupActivation[] = []
 
     for (const group of groups) {
-      const allWords = [...group.words, ...group.autoLearned]
-      if (allWords.length === 0) continue
+      let matcher = this.matcherCache.get(group.name)
+      if (!matcher) {
+        const all = [...group.words, ...group.autoLearned]
+        matcher = { all, lowered: all.map((word) => word.toLowerCase()) }
+        this.matcherCache.set(group.name, matcher)
+      }
+      if (matcher.all.length === 0) continue
 
-      const matchedWords = allWords.filter((word) => lowerText.includes(word.toLowerCase()))
+      const matchedWords: string[] = []
+      for (let i = 0; i < matcher.lowered.length; i++) {
+        if (lowerText.includes(matcher.lowered[i])) matchedWords.push(matcher.all[i])
+      }
 
       if (matchedWords.length > 0) {
-        const strength = matchedWords.length / allWords.length
+        const strength = matchedWords.length / matcher.all.length
         activations.push({
           groupName: group.name,
           strength,
@@ -223,6 +271,7 @@ export class SemanticGroupManager {
    * @returns { updated, failed, errors } 更新数、失败数、错误信息
    */
   async precomputeGroupVectors(model: string): Promise<{ updated: number; failed: number; errors: string[] }> {
+    this.lastVectorModel = model
     const groups = this.getAllGroups()
     let updated = 0
     let failed = 0
@@ -259,13 +308,53 @@ export class SemanticGroupManager {
       }
     }
 
+    this.staleGroups.clear()
     return { updated, failed, errors }
   }
 
+  /**
+   * 增量重算：只处理最近插入/更新过词元的组。词元变更后会自动延迟调度，
+   * 也可显式传入模型立即触发；模型未知时保持排队，等首次全量预计算
+   */
+  async refreshStaleGroupVectors(model?: string): Promise<{ updated: number; failed: number; errors: string[] }> {
+    const effectiveModel = model ?? this.lastVectorModel
+    if (!effectiveModel) return { updated: 0, failed: 0, errors: [] }
+    this.lastVectorModel = effectiveModel
+
+    const names = Array.from(this.staleGroups)
+    let updated = 0
+    let failed = 0
+    const errors: string[] = []
+
+    for (const name of names) {
+      this.staleGroups.delete(name)
+      if (!this.getGroup(name)) continue
+      try {
+        if (await this.precomputeSingleGroupVector(name, effectiveModel)) {
+          updated++
+        } else {
+          failed++
+          errors.push(`语义组 "${name}" 向量计算失败: Embedding API 返回空结果`)
+        }
+      } catch (err) {
+        failed++
+        errors.push(`语义组 "${name}" 向量计算失败: ${err instanceof Error ? err.message : String(err)}`)
+      }
+    }
+
+    return { updated, failed, errors }
+  }
+
+  /** 是否有待增量重算的组 */
+  hasStaleGroups(): boolean {
+    return this.staleGroups.size > 0
+  }
+
   /**
    * 预计算单个语义组的向量
    */
   async precomputeSingleGroupVector(name: string, model: string): Promise<boolean> {
+    this.lastVectorModel = model
     const group = this.getGroup(name)
     if (!group) return false
 
@@ -278,6 +367,7 @@ export class SemanticGroupManager {
     if (embedding && embedding.length >= 8) {
       const currentHash = this.computeWordsHash(allWords)
       await this.saveGroupVector(name, embedding, model, currentHash)
+      this.staleGroups.delete(name)
       console.log(`[SemanticGroup] 已更新组向量: ${name}`)
       return true
     }
@@ -296,6 +386,7 @@ export class SemanticGroupManager {
    * 获取所有语义组
    */
   getAllGroups(): SemanticGroup[] {
+    if (this.groupListCache) return this.groupListCache
     const rows = this.db
       .prepare('SELECT * FROM semantic_group ORDER BY name')
       .all() as Array<{
@@ -312,7 +403,7 @@ export class SemanticGroupManager {
       updated_at: number
     }>
 
-    return rows.map((r) => ({
+    this.groupListCache = rows.map((r) => ({
       name: r.name,
       words: JSON.parse(r.words),
       autoLearned: JSON.parse(r.auto_learned),
@@ -324,6 +415,7 @@ export class SemanticGroupManager {
       createdAt: r.created_at,
       updatedAt: r.updated_at,
     }))
+    return this.groupListCache
   }
 
   /**
@@ -346,6 +438,8 @@ export class SemanticGroupManager {
    * 获取单个语义组
    */
   getGroup(name: string): SemanticGroup | null {
+    const cached = this.groupListCache?.find((g) => g.name === name)
+    if (cached) return cached
     const row = this.db.prepare('SELECT * FROM semantic_group WHERE name = ?').get(name) as
       | {
           name: string
@@ -394,6 +488,8 @@ export class SemanticGroupManager {
       )
       .run(name.trim(), JSON.stringify(cleanWords), clampFloat(weight, 1.0, 0.1, 10.0), ts, ts)
 
+    this.invalidateGroupCache(name.trim())
+    this.markGroupStale(name.trim())
     return this.getGroup(name.trim())!
   }
 
@@ -419,8 +515,10 @@ export class SemanticGroupManager {
       )
       .run(JSON.stringify(newWords), JSON.stringify(newAutoLearned), newWeight, ts, name)
 
-    // 清除向量缓存，下次预计算时会重新生成
+    // 清除向量缓存；词元变化时只把本组标脏，增量重算即可
     this.vectorCache.delete(name)
+    this.invalidateGroupCache(name)
+    if (words !== undefined || autoLearned !== undefined) this.markGroupStale(name)
 
     return this.getGroup(name)
   }
@@ -434,6 +532,8 @@ export class SemanticGroupManager {
 
     const result = this.db.prepare('DELETE FROM semantic_group WHERE name = ?').run(name)
     this.vectorCache.delete(name)
+    this.invalidateGroupCache(name)
+    this.staleGroups.delete(name)
     return result.changes > 0
   }
 
@@ -449,6 +549,12 @@ export class SemanticGroupManager {
            WHERE name = ?`
         )
         .run(ts, name)
+      // 激活统计只改计数字段，原地更新缓存即可，不必整表重读
+      const cached = this.groupListCache?.find((g) => g.name === name)
+      if (cached) {
+        cached.lastActivatedAt = ts
+        cached.activationCount += 1
+      }
     } catch (err) {
       console.error('[SemanticGroup] 更新激活统计失败:', err)
     }
@@ -534,6 +640,7 @@ export class SemanticGroupManager {
 
     // 更新缓存
     this.vectorCache.set(name, { vec, model })
+    this.invalidateGroupCache(name)
   }
 
   private deleteGroupVector(name: string): void {
@@ -550,6 +657,7 @@ export class SemanticGroupManager {
       .run(now(), name)
 
     this.vectorCache.delete(name)
+    this.invalidateGroupCache(name)
   }
 
   // ========== 自学习辅助 ==========
@@ -1310,13 +1310,16 @@ function requireStore(): Store<AppSettings> {
 }
 
 export function installSettingsSecretAdapter(adapter: SettingsSecretAdapter): AppSettings {
+  flushSettingsWrites()
   const currentStore = requireStore()
   const persisted = normalizeSettings(currentStore.store)
   const effective = adapter.hydrate(persisted)
   const sanitized = adapter.persist(effective)
   currentStore.store = sanitized
   settingsSecretAdapter = adapter
-  settingsCache = adapter.hydrate(normalizeSettings(currentStore.store))
+  const normalizedPersisted = normalizeSettings(currentStore.store)
+  lastPersistedSettings = normalizedPersisted
+  settingsCache = adapter.hydrate(normalizedPersisted)
   return settingsCache
 }
 
@@ -1324,9 +1327,55 @@ export function installSettingsSecretAdapter(adapter: SettingsSecretAdapter): Ap
 // 调用方必须把返回值当作只读；所有写入都必须走 setSettings 以刷新缓存。
 let settingsCache: AppSettings | null = null
 
+// 防抖落盘：设置窗口的滑杆（气泡透明度、模型缩放等）每个 tick 都会触发 setSettings，
+// 设置文件带上 MCP 配置和人设后已超过数百 KB，逐次全量重写会卡住主进程。
+// setSettings 只同步更新内存缓存并按顶层节做脏标记，落盘合并到一个节流定时器里；
+// 所有节都回到上次已落盘的状态时跳过写入。退出路径必须调用 flushSettingsWrites() 兜底。
+const SETTINGS_PERSIST_DELAY_MS = 800
+let lastPersistedSettings: AppSettings | null = null
+let pendingPersistSettings: AppSettings | null = null
+let persistTimer: ReturnType<typeof setTimeout> | null = null
+const dirtySettingsSections = new Set<string>()
+
+function refreshDirtySettingsSections(baseline: AppSettings, next: AppSettings): void {
+  dirtySettingsSections.clear()
+  const baselineRecord = baseline as unknown as Record<string, unknown>
+  const nextRecord = next as unknown as Record<string, unknown>
+  for (const key of new Set([...Object.keys(baselineRecord), ...Object.keys(nextRecord)])) {
+    if (JSON.stringify(baselineRecord[key]) !== JSON.stringify(nextRecord[key])) dirtySettingsSections.add(key)
+  }
+}
+
+function schedulePersistSettings(): void {
+  if (persistTimer) return
+  persistTimer = setTimeout(() => {
+    persistTimer = null
+    flushSettingsWrites()
+  }, SETTINGS_PERSIST_DELAY_MS)
+  persistTimer.unref?.()
+}
+
+/** 把尚未落盘的设置变更立刻写入文件（应用退出前必须调用，否则防抖窗口内的改动会丢失）。 */
+export function flushSettingsWrites(): void {
+  if (persistTimer) {
+    clearTimeout(persistTimer)
+    persistTimer = null
+  }
+  const pending = pendingPersistSettings
+  pendingPersistSettings = null
+  if (!pending || dirtySettingsSections.size === 0) {
+    dirtySettingsSections.clear()
+    return
+  }
+  requireStore().store = pending
+  lastPersistedSettings = pending
+  dirtySettingsSections.clear()
+}
+
 export function getSettings(): AppSettings {
   if (!settingsCache) {
     const persisted = normalizeSettings(requireStore().store)
+    lastPersistedSettings ??= persisted
     settingsCache = settingsSecretAdapter ? settingsSecretAdapter.hydrate(persisted) : persisted
   }
   return settingsCache
@@ -1335,10 +1384,13 @@ export function getSettings(): AppSettings {
 export function setSettings(next: Partial<AppSettings>): AppSettings {
   const current = getSettings()
   const merged: AppSettings = normalizeSettings({ ...current, ...next })
-  const currentStore = requireStore()
   const persisted = settingsSecretAdapter ? settingsSecretAdapter.persist(merged) : merged
-  currentStore.store = persisted
-  const normalizedPersisted = normalizeSettings(currentStore.store)
+  const baseline = lastPersistedSettings ?? normalizeSettings(requireStore().store)
+  lastPersistedSettings = baseline
+  refreshDirtySettingsSections(baseline, persisted)
+  pendingPersistSettings = persisted
+  if (dirtySettingsSections.size > 0) schedulePersistSettings()
+  const normalizedPersisted = normalizeSettings(persisted)
   settingsCache = settingsSecretAdapter ? settingsSecretAdapter.hydrate(normalizedPersisted) : normalizedPersisted
   return settingsCache
 }
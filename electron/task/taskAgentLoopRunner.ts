@@ -1,7 +1,9 @@
+import { isToolSerialOnly } from '../toolRegistry'
 import { buildToolResultBlock, hasToolRequestMarker, type TaskAgentToolCatalog } from './taskAgentTools'
 import type { TaskAgentConversation } from './taskAgentConversation'
 import type { TaskAgentLlmClient } from './taskAgentLlmClient'
 import { isAbortLikeError, type TaskAgentApiMode } from './taskAgentLlmProtocol'
+import { runToolCallBatch } from './taskAgentToolScheduler'
 import type { TaskAgentToolSession } from './taskAgentToolSession'
 
 export type TaskAgentLoopMode = 'auto' | 'native' | 'text'
@@ -111,10 +113,19 @@ export class TaskAgentLoopRunner {
       }
 
       this.pushLog(`[Agent] tool_calls: ${toolCalls.map((call) => call.function.name).join(', ')}`)
+      // 无依赖的调用并行执行，serialOnly 工具保持原有顺序屏障；结果按原始顺序追加
+      const results = await runToolCallBatch(toolCalls, {
+        isSerial: (call) => isToolSerialOnly(call.function.name),
+        onParallelGroup: (size) => this.pushLog(`[Agent] run ${size} independent tool calls in parallel`),
+        execute: async (call) => {
+          await this.waitForResume()
+          return this.toolSession.executeNative(call)
+        },
+      })
       const pendingVisionMessages: Array<Record<string, unknown>> = []
-      for (const call of toolCalls) {
-        await this.waitForResume()
-        const result = await this.toolSession.executeNative(call)
+      for (let i = 0; i < toolCalls.length; i += 1) {
+        const call = toolCalls[i]
+        const result = results[i]
         this.messages.push({
           role: 'tool',
           tool_call_id: call.id,
@@ -166,10 +177,17 @@ export class TaskAgentLoopRunner {
       }
 
       this.pushLog(`[Agent] tool_requests: ${calls.map((call) => call.toolName).join(', ')}`)
-      for (const call of calls) {
-        await this.waitForResume()
-        const result = await this.toolSession.executeText(call.toolName, call.input ?? {})
-        const toolResultBlock = buildToolResultBlock(call.toolName, result.toolMessage)
+      const results = await runToolCallBatch(calls, {
+        isSerial: (call) => isToolSerialOnly(call.toolName),
+        onParallelGroup: (size) => this.pushLog(`[Agent] run ${size} independent tool calls in parallel`),
+        execute: async (call) => {
+          await this.waitForResume()
+          return this.toolSession.executeText(call.toolName, call.input ?? {})
+        },
+      })
+      for (let i = 0; i < calls.length; i += 1) {
+        const result = results[i]
+        const toolResultBlock = buildToolResultBlock(calls[i].toolName, result.toolMessage)
         this.messages.push(
           result.visionParts.length > 0
             ? { role: 'user', content: [{ type: 'text', text: toolResultBlock }, ...result.visionParts] }
@@ -0,0 +1,78 @@
+// 同一轮 assistant 消息里的多个工具调用此前严格串行，整轮耗时是所有调用之和。
+// 这里把批次切成组：serialOnly 工具（共享会话/有副作用，见 toolRegistry）独占一组、
+// 前后都是屏障；连续的可并行调用合为一组，在并发上限内同时执行。结果仍按原始
+// 调用顺序返回，消息追加顺序与串行实现完全一致。
+
+export const TOOL_BATCH_MAX_PARALLEL = 4
+
+export type ToolBatchOptions<TCall, TResult> = {
+  isSerial: (call: TCall) => boolean
+  execute: (call: TCall, index: number) => Promise<TResult>
+  maxParallel?: number
+  /** 并行组开始执行时回调（仅组内调用数 > 1 时触发，用于日志） */
+  onParallelGroup?: (size: number) => void
+}
+
+type ToolBatchGroup<TCall> = { start: number; calls: TCall[]; serial: boolean }
+
+export function planToolCallGroups<TCall>(calls: TCall[], isSerial: (call: TCall) => boolean): Array<ToolBatchGroup<TCall>> {
+  const groups: Array<ToolBatchGroup<TCall>> = []
+  for (let i = 0; i < calls.length; i += 1) {
+    const call = calls[i]
+    if (isSerial(call)) {
+      groups.push({ start: i, calls: [call], serial: true })
+      continue
+    }
+    const last = groups[groups.length - 1]
+    if (last && !last.serial) last.calls.push(call)
+    else groups.push({ start: i, calls: [call], serial: false })
+  }
+  return groups
+}
+
+export async function runToolCallBatch<TCall, TResult>(
+  calls: TCall[],
+  options: ToolBatchOptions<TCall, TResult>,
+): Promise<TResult[]> {
+  const maxParallel = Math.max(1, Math.trunc(options.maxParallel ?? TOOL_BATCH_MAX_PARALLEL))
+  const results = new Array<TResult>(calls.length)
+
+  for (const group of planToolCallGroups(calls, options.isSerial)) {
+    if (group.serial || group.calls.length === 1 || maxParallel === 1) {
+      for (let j = 0; j < group.calls.length; j += 1) {
+        const index = group.start + j
+        results[index] = await options.execute(group.calls[j], index)
+      }
+      continue
+    }
+
+    options.onParallelGroup?.(group.calls.length)
+
+    // 有限并发池：出错后不再启动新调用，但等在途调用落定再抛出第一个错误，
+    // 避免悬挂的兄弟 promise 变成未处理拒绝
+    let cursor = 0
+    let failed = false
+    let firstError: unknown
+    const worker = async () => {
+      for (;;) {
+        if (failed) return
+        const j = cursor
+        if (j >= group.calls.length) return
+        cursor += 1
+        const index = group.start + j
+        try {
+          results[index] = await options.execute(group.calls[j], index)
+        } catch (err) {
+          if (!failed) {
+            failed = true
+            firstError = err
+          }
+        }
+      }
+    }
+    await Promise.all(Array.from({ length: Math.min(maxParallel, group.calls.length) }, () => worker()))
+    if (failed) throw firstError
+  }
+
+  return results
+}
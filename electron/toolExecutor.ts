@@ -3,6 +3,7 @@ import * as fs from 'node:fs/promises'
 import * as os from 'node:os'
 import * as path from 'node:path'
 import { getSettings } from './store'
+import { startSpan } from './tracing'
 import { isToolEnabled } from './toolRegistry'
 import { getLive2dCapabilities } from './live2dToolState'
 import { getWindowManagerInstance } from './runtimeRefs'
@@ -10,6 +11,7 @@ import { readLive2dModelMetadata } from './live2dModelMetadata'
 import { buildOpenAICompatReasoningOptions } from './reasoningConfig'
 import { SkillManager, type SkillManagerRuntimeOptions } from './skillRegistry'
 import { captureScreenToFile, type ScreenCaptureRegion } from './screenCaptureService'
+import { VideoQaFrameCache, videoContentHash, type VideoQaFrameExtraction } from './videoQaFrameCache'
 import { generateNovelAIImages } from './novelAiImageService'
 import { resolveVisionFallbackProfile } from './visionRouter'
 import {
@@ -553,6 +555,21 @@ export async function executeBuiltinTool(
   input: ToolInput,
   ctx: ToolExecutionContext,
   opts?: { maxStepOutputChars?: number },
+): Promise<string> {
+  // 工具执行 span：按工具名聚合耗时，慢工具在追踪面板里直接可见
+  const endSpan = startSpan('tool', (toolNameRaw ?? '').trim() || 'unknown')
+  try {
+    return await executeBuiltinToolInner(toolNameRaw, input, ctx, opts)
+  } finally {
+    endSpan()
+  }
+}
+
+async function executeBuiltinToolInner(
+  toolNameRaw: string,
+  input: ToolInput,
+  ctx: ToolExecutionContext,
+  opts?: { maxStepOutputChars?: number },
 ): Promise<string> {
   const toolName = (toolNameRaw ?? '').trim()
   const maxStepOutputChars = typeof opts?.maxStepOutputChars === 'number' ? opts.maxStepOutputChars : 5000
@@ -1826,6 +1843,7 @@ export async function executeBuiltinTool(
     const framesPerSegment = typeof obj?.framesPerSegment === 'number' ? Math.max(1, Math.min(8, Math.trunc(obj.framesPerSegment))) : 3
     const maxSegments = typeof obj?.maxSegments === 'number' ? Math.max(1, Math.min(60, Math.trunc(obj.maxSegments))) : 8
     const startSeconds = typeof obj?.startSeconds === 'number' ? Math.max(0, Math.min(1e9, obj.startSeconds)) : 0
+    const extractWorkers = typeof obj?.workers === 'number' ? Math.max(0, Math.min(16, Math.trunc(obj.workers))) : 0
 
     const maxTokensPerSegment =
       typeof obj?.maxTokensPerSegment === 'number' ? Math.max(64, Math.min(2048, Math.trunc(obj.maxTokensPerSegment))) : 320
@@ -1924,14 +1942,8 @@ export async function executeBuiltinTool(
       throw new Error('未找到 video_qa_extract_frames.py（请确认源码目录存在 electron/tools/video_qa_extract_frames.py）')
     }
 
-    const runExtractor = async (): Promise<{
-      ok: true
-      durationSec: number
-      fps: number
-      segments: Array<{ index: number; startSec: number; endSec: number; frames: string[] }>
-    }> => {
+    const runExtractor = async (outDir: string): Promise<VideoQaFrameExtraction> => {
       const scriptPath = await resolveExtractorPath()
-      const outDir = path.join(ctx.userDataDir, 'video-qa', ctx.task.id, `${Date.now().toString(36)}-${Math.random().toString(36).slice(2)}`)
       await fs.mkdir(outDir, { recursive: true })
 
       const pythonArgs = [
@@ -1948,6 +1960,8 @@ export async function executeBuiltinTool(
         String(maxSegments),
         '--start-seconds',
         String(startSeconds),
+        '--workers',
+        String(extractWorkers),
       ]
 
       const tryRun = async (exe: string): Promise<{ code: number | null; stdout: string; stderr: string }> => {
@@ -1999,11 +2013,32 @@ export async function executeBuiltinTool(
 
       const durationSec = typeof parsed.durationSec === 'number' ? parsed.durationSec : 0
       const fps = typeof parsed.fps === 'number' ? parsed.fps : 0
-      return { ok: true, durationSec, fps, segments }
+      return { durationSec, fps, segments }
     }
 
     if (Date.now() - startedAt > timeoutMs) throw new Error('timeout before extraction')
-    const extracted = await runExtractor()
+
+    // 抽帧按（视频内容哈希, 采样配置）缓存：同一视频的后续提问直接复用帧文件，
+    // 只付 LLM 调用的成本
+    const samplingConfig = { segmentSeconds, framesPerSegment, maxSegments, startSeconds }
+    const frameCache = new VideoQaFrameCache({ cacheRoot: path.join(ctx.userDataDir, 'video-qa', 'frame-cache') })
+    let extracted: VideoQaFrameExtraction | null = null
+    let frameCacheHit = false
+    let contentHash = ''
+    try {
+      contentHash = await videoContentHash(videoPath)
+      extracted = await frameCache.lookup(contentHash, samplingConfig)
+      frameCacheHit = extracted !== null
+    } catch {
+      // 缓存不可用就按老路径现场抽帧
+    }
+    if (!extracted) {
+      const outDir = contentHash
+        ? frameCache.cacheDirFor(contentHash, samplingConfig)
+        : path.join(ctx.userDataDir, 'video-qa', ctx.task.id, `${Date.now().toString(36)}-${Math.random().toString(36).slice(2)}`)
+      extracted = await runExtractor(outDir)
+      if (contentHash) await frameCache.store(contentHash, samplingConfig, extracted).catch(() => undefined)
+    }
 
     type SegmentAnswer = { index: number; startSec: number; endSec: number; frameCount: number; answer: string }
     const segmentAnswers: SegmentAnswer[] = []
@@ -2100,7 +2135,7 @@ export async function executeBuiltinTool(
       videoPath,
       question,
       params: { segmentSeconds, framesPerSegment, maxSegments, startSeconds },
-      extracted: { durationSec: extracted.durationSec, fps: extracted.fps, segments: extracted.segments.length },
+      extracted: { durationSec: extracted.durationSec, fps: extracted.fps, segments: extracted.segments.length, frameCacheHit },
       segments: segmentAnswers,
       final: (summary ?? '').trim() || '(空)',
       note: '该工具按时间分段抽帧并逐段调用视觉模型；成本≈段数次 API 调用。答案只基于采样帧，可能漏掉快速变化内容。',
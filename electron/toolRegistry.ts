@@ -21,6 +21,9 @@ export type ToolDefinition = {
   cost: ToolCostLevel
   tags: string[]
   version: string
+  // 声明为 true 的工具不与同批次的其它工具并行（共享会话/有副作用/依赖执行顺序）。
+  // 未声明的内置工具与外部工具（MCP 等）默认视为可并行的只读调用。
+  serialOnly?: boolean
 }
 
 export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
@@ -73,6 +76,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'low',
     cost: 'low',
+    serialOnly: true,
     tags: ['browser', 'open'],
     version: '1.0',
   },
@@ -140,6 +144,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'medium',
     cost: 'high',
+    serialOnly: true,
     tags: ['browser', 'automation', 'dynamic'],
     version: '1.0',
   },
@@ -160,6 +165,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     examples: [{ title: '列出默认 profile 标签页', input: { profile: 'default' } }],
     risk: 'low',
     cost: 'low',
+    serialOnly: true,
     tags: ['browser', 'tabs', 'automation'],
     version: '1.0',
   },
@@ -190,6 +196,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'low',
     cost: 'medium',
+    serialOnly: true,
     tags: ['browser', 'scan', 'automation', 'low-token'],
     version: '1.0',
   },
@@ -228,6 +235,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'medium',
     cost: 'medium',
+    serialOnly: true,
     tags: ['browser', 'javascript', 'automation'],
     version: '1.0',
   },
@@ -255,6 +263,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'low',
     cost: 'medium',
+    serialOnly: true,
     tags: ['browser', 'screenshot', 'automation'],
     version: '1.0',
   },
@@ -332,6 +341,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'medium',
     cost: 'low',
+    serialOnly: true,
     tags: ['browser', 'tabs', 'cleanup'],
     version: '1.0',
   },
@@ -357,6 +367,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'medium',
     cost: 'low',
+    serialOnly: true,
     tags: ['browser', 'cleanup', 'close'],
     version: '1.0',
   },
@@ -390,6 +401,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     examples: [{ title: '刷新技能缓存', input: {} }],
     risk: 'low',
     cost: 'low',
+    serialOnly: true,
     tags: ['skill', 'refresh'],
     version: '1.0',
   },
@@ -414,6 +426,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'medium',
     cost: 'medium',
+    serialOnly: true,
     tags: ['skill', 'install', 'git'],
     version: '1.0',
   },
@@ -486,6 +499,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'medium',
     cost: 'low',
+    serialOnly: true,
     tags: ['file', 'io'],
     version: '1.0',
   },
@@ -532,6 +546,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'high',
     cost: 'medium',
+    serialOnly: true,
     tags: ['cli', 'process', 'stream'],
     version: '1.0',
   },
@@ -562,6 +577,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'high',
     cost: 'medium',
+    serialOnly: true,
     tags: ['cli', 'process'],
     version: '1.0',
   },
@@ -742,6 +758,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
         framesPerSegment: { type: 'integer', description: '每段抽帧数量（默认 3）', minimum: 1, maximum: 8 },
         maxSegments: { type: 'integer', description: '最多处理多少段（默认 8）', minimum: 1, maximum: 60 },
         startSeconds: { type: 'number', description: '从视频第几秒开始（默认 0）', minimum: 0, maximum: 1000000000 },
+        workers: { type: 'integer', description: '抽帧并行解码进程数（默认 0 = 自动，按 CPU 核数封顶 8）', minimum: 0, maximum: 16 },
         timeoutMs: { type: 'integer', description: '总超时毫秒（默认 120000）', minimum: 5000, maximum: 600000 },
         baseUrl: { type: 'string', description: '可选覆盖 baseUrl（需支持 vision 输入）' },
         apiKey: { type: 'string', description: '可选覆盖 apiKey' },
@@ -865,6 +882,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     ],
     risk: 'low',
     cost: 'low',
+    serialOnly: true,
     tags: ['live2d', 'params', 'animation'],
     version: '1.0',
   },
@@ -882,6 +900,7 @@ export const BUILTIN_TOOL_DEFINITIONS: ToolDefinition[] = [
     examples: [{ title: '等待 1 秒', input: { ms: 1000 } }],
     risk: 'low',
     cost: 'low',
+    serialOnly: true,
     tags: ['delay'],
     version: '1.0',
   },
@@ -960,6 +979,11 @@ export function findToolByCallName(callName: string): ToolDefinition | null {
   return null
 }
 
+export function isToolSerialOnly(nameOrCallName: string): boolean {
+  const def = findToolByName(nameOrCallName) ?? findToolByCallName(nameOrCallName)
+  return def?.serialOnly === true
+}
+
 export type OpenAIFunctionToolSpec = {
   type: 'function'
   function: { name: string; description: string; parameters: Record<string, unknown> }
@@ -23,6 +23,87 @@ def clamp_float(v: Any, fallback: float, min_v: float, max_v: float) -> float:
     return max(min_v, min(max_v, n))
 
 
+def build_segment_jobs(
+    duration_sec: float, seg_seconds: int, frames_per_seg: int, max_segs: int, start_seconds: float
+) -> List[Dict[str, Any]]:
+    jobs: List[Dict[str, Any]] = []
+    for seg_idx in range(max_segs):
+        seg_start = start_seconds + float(seg_idx * seg_seconds)
+        if duration_sec > 0.0 and seg_start >= duration_sec:
+            break
+        seg_end = seg_start + float(seg_seconds)
+        if duration_sec > 0.0:
+            seg_end = min(seg_end, duration_sec)
+
+        # 均匀采样：用 (i+0.5)/N 取中点，避免总是取到切点帧
+        times: List[float] = []
+        for i in range(frames_per_seg):
+            t = seg_start + (i + 0.5) * (float(seg_seconds) / float(frames_per_seg))
+            if t < seg_start:
+                t = seg_start
+            if t > seg_end:
+                t = max(seg_start, seg_end - 0.001)
+            if duration_sec > 0.0:
+                t = min(t, max(0.0, duration_sec - 0.001))
+            times.append(t)
+
+        jobs.append({"index": seg_idx, "startSec": seg_start, "endSec": seg_end, "times": times})
+    return jobs
+
+
+def extract_segment_range(video_path: str, out_dir: str, jobs: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+    """解码一段连续的片段区间；每个 worker 进程持有自己的解码器，只做向前 seek。"""
+    import cv2  # type: ignore
+
+    cap = cv2.VideoCapture(video_path)
+    if not cap.isOpened():
+        return []
+
+    segments: List[Dict[str, Any]] = []
+    for job in jobs:
+        frame_paths: List[str] = []
+        for t in job["times"]:
+            cap.set(cv2.CAP_PROP_POS_MSEC, max(0.0, float(t)) * 1000.0)
+            ok, frame = cap.read()
+            if not ok or frame is None:
+                continue
+            # 命名只依赖片段号和时间戳：并行与串行产出完全一致，下游按路径消费不受影响
+            name = f"seg{int(job['index']):03d}_t{int(float(t)*1000):010d}.jpg"
+            out_path = os.path.join(out_dir, name)
+            try:
+                cv2.imwrite(out_path, frame, [int(cv2.IMWRITE_JPEG_QUALITY), 85])
+                frame_paths.append(os.path.abspath(out_path))
+            except Exception:
+                continue
+
+        segments.append(
+            {
+                "index": job["index"],
+                "startSec": job["startSec"],
+                "endSec": job["endSec"],
+                "frames": frame_paths,
+            }
+        )
+
+    cap.release()
+    return segments
+
+
+def split_contiguous(jobs: List[Dict[str, Any]], parts: int) -> List[List[Dict[str, Any]]]:
+    # 连续切分而不是轮转：每个解码器在自己的时间区间内顺序 seek，避免来回跳
+    n = len(jobs)
+    parts = max(1, min(parts, n))
+    out: List[List[Dict[str, Any]]] = []
+    base = n // parts
+    extra = n % parts
+    pos = 0
+    for i in range(parts):
+        size = base + (1 if i < extra else 0)
+        out.append(jobs[pos : pos + size])
+        pos += size
+    return out
+
+
 def main() -> None:
     parser = argparse.ArgumentParser()
     parser.add_argument("--video", required=True)
@@ -31,6 +112,7 @@ def main() -> None:
     parser.add_argument("--frames-per-segment", default="3")
     parser.add_argument("--max-segments", default="8")
     parser.add_argument("--start-seconds", default="0")
+    parser.add_argument("--workers", default="0", help="并行解码进程数；0 = 自动（CPU 核数，封顶 8）")
     args = parser.parse_args()
 
     video_path = os.path.abspath(args.video)
@@ -51,68 +133,39 @@ def main() -> None:
     frames_per_seg = clamp_int(args.frames_per_segment, 3, 1, 8)
     max_segs = clamp_int(args.max_segments, 8, 1, 60)
     start_seconds = clamp_float(args.start_seconds, 0.0, 0.0, 1e9)
+    workers = clamp_int(args.workers, 0, 0, 16)
+    if workers <= 0:
+        workers = min(8, os.cpu_count() or 1)
 
+    # 父进程只读元信息，解码全部交给 worker
     cap = cv2.VideoCapture(video_path)
     if not cap.isOpened():
         print(json.dumps({"ok": False, "error": "failed to open video", "videoPath": video_path}))
         return
-
     fps = float(cap.get(cv2.CAP_PROP_FPS) or 0.0)
     frame_count = float(cap.get(cv2.CAP_PROP_FRAME_COUNT) or 0.0)
     duration_sec = (frame_count / fps) if fps > 0.0 and frame_count > 0.0 else 0.0
+    cap.release()
 
-    def safe_read_at_time(t: float):
-        cap.set(cv2.CAP_PROP_POS_MSEC, max(0.0, t) * 1000.0)
-        ok, frame = cap.read()
-        if not ok or frame is None:
-            return None
-        return frame
+    jobs = build_segment_jobs(duration_sec, seg_seconds, frames_per_seg, max_segs, start_seconds)
 
     segments: List[Dict[str, Any]] = []
-
-    for seg_idx in range(max_segs):
-        seg_start = start_seconds + float(seg_idx * seg_seconds)
-        if duration_sec > 0.0 and seg_start >= duration_sec:
-            break
-        seg_end = seg_start + float(seg_seconds)
-        if duration_sec > 0.0:
-            seg_end = min(seg_end, duration_sec)
-
-        # 均匀采样：用 (i+0.5)/N 取中点，避免总是取到切点帧
-        times: List[float] = []
-        for i in range(frames_per_seg):
-            t = seg_start + (i + 0.5) * (float(seg_seconds) / float(frames_per_seg))
-            if t < seg_start:
-                t = seg_start
-            if t > seg_end:
-                t = max(seg_start, seg_end - 0.001)
-            if duration_sec > 0.0:
-                t = min(t, max(0.0, duration_sec - 0.001))
-            times.append(t)
-
-        frame_paths: List[str] = []
-        for t in times:
-            frame = safe_read_at_time(t)
-            if frame is None:
-                continue
-            name = f"seg{seg_idx:03d}_t{int(t*1000):010d}.jpg"
-            out_path = os.path.join(out_dir, name)
-            try:
-                cv2.imwrite(out_path, frame, [int(cv2.IMWRITE_JPEG_QUALITY), 85])
-                frame_paths.append(os.path.abspath(out_path))
-            except Exception:
-                continue
-
-        segments.append(
-            {
-                "index": seg_idx,
-                "startSec": seg_start,
-                "endSec": seg_end,
-                "frames": frame_paths,
-            }
-        )
-
-    cap.release()
+    if workers > 1 and len(jobs) > 1:
+        try:
+            from multiprocessing import Pool
+
+            chunks = split_contiguous(jobs, workers)
+            with Pool(processes=len(chunks)) as pool:
+                parts = pool.starmap(extract_segment_range, [(video_path, out_dir, chunk) for chunk in chunks])
+            for part in parts:
+                segments.extend(part)
+        except Exception:
+            # 并行失败（例如受限环境禁 fork/spawn）回退串行，结果不变
+            segments = extract_segment_range(video_path, out_dir, jobs)
+    else:
+        segments = extract_segment_range(video_path, out_dir, jobs)
+
+    segments.sort(key=lambda s: int(s["index"]))
 
     out: Dict[str, Any] = {
         "ok": True,
@@ -124,6 +177,7 @@ def main() -> None:
         "segmentSeconds": seg_seconds,
         "framesPerSegment": frames_per_seg,
         "startSeconds": start_seconds,
+        "workers": workers,
         "segments": segments,
     }
     print(json.dumps(out, ensure_ascii=False))
@@ -131,4 +185,3 @@ def main() -> None:
 
 if __name__ == "__main__":
     main()
-
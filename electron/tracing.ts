@@ -0,0 +1,208 @@
+// 轻量级常驻追踪层：IPC 处理器、工具执行、记忆操作的耗时 span + 事件循环卡顿采样。
+// 设计目标是"始终开启也感知不到"：记录一条 span 只是两次 Map 查找和几次数字累加，
+// 分位数在取快照时才计算。最近的 span 同时进一个有界环，可导出为 Chrome trace
+// 事件格式（chrome://tracing / Perfetto 可直接打开）。
+
+// 每个 span key 保留最近 N 次耗时样本用于 p50/p99；环形覆盖，老样本自然淘汰
+const SPAN_SAMPLE_WINDOW = 256
+const TRACE_EVENT_RING_CAPACITY = 4_000
+const LAG_SAMPLE_WINDOW = 240
+const DEFAULT_LAG_SAMPLE_INTERVAL_MS = 500
+
+export type TraceSpanStat = {
+  category: string
+  name: string
+  count: number
+  totalMs: number
+  maxMs: number
+  p50Ms: number
+  p99Ms: number
+}
+
+export type TraceLagStat = {
+  target: string
+  samples: number
+  p50Ms: number
+  p99Ms: number
+  maxMs: number
+}
+
+export type TraceSnapshot = {
+  startedAt: number
+  spans: TraceSpanStat[]
+  eventLoop: TraceLagStat[]
+}
+
+type SpanAggregate = {
+  category: string
+  name: string
+  count: number
+  totalMs: number
+  maxMs: number
+  recent: number[]
+  recentPos: number
+}
+
+type TraceEvent = {
+  name: string
+  cat: string
+  ts: number
+  dur: number
+}
+
+type LagAggregate = {
+  maxMs: number
+  recent: number[]
+  recentPos: number
+  sampleCount: number
+}
+
+const tracingStartedAt = Date.now()
+const spanAggregates = new Map<string, SpanAggregate>()
+const lagAggregates = new Map<string, LagAggregate>()
+const traceEventRing: (TraceEvent | null)[] = new Array(TRACE_EVENT_RING_CAPACITY).fill(null)
+let traceEventHead = 0
+let traceEventCount = 0
+
+function pushSample(recent: number[], pos: number, value: number, capacity: number): number {
+  if (recent.length < capacity) {
+    recent.push(value)
+    return pos
+  }
+  recent[pos] = value
+  return (pos + 1) % capacity
+}
+
+function percentile(sorted: number[], quantile: number): number {
+  if (sorted.length === 0) return 0
+  const index = Math.min(sorted.length - 1, Math.max(0, Math.ceil(quantile * sorted.length) - 1))
+  return sorted[index]
+}
+
+export function recordSpan(category: string, name: string, durationMs: number): void {
+  const key = `${category}:${name}`
+  let aggregate = spanAggregates.get(key)
+  if (!aggregate) {
+    aggregate = { category, name, count: 0, totalMs: 0, maxMs: 0, recent: [], recentPos: 0 }
+    spanAggregates.set(key, aggregate)
+  }
+  aggregate.count += 1
+  aggregate.totalMs += durationMs
+  if (durationMs > aggregate.maxMs) aggregate.maxMs = durationMs
+  aggregate.recentPos = pushSample(aggregate.recent, aggregate.recentPos, durationMs, SPAN_SAMPLE_WINDOW)
+
+  const event: TraceEvent = {
+    name,
+    cat: category,
+    ts: Math.round((Date.now() - durationMs) * 1_000),
+    dur: Math.round(durationMs * 1_000),
+  }
+  if (traceEventCount === TRACE_EVENT_RING_CAPACITY) {
+    traceEventRing[traceEventHead] = event
+    traceEventHead = (traceEventHead + 1) % TRACE_EVENT_RING_CAPACITY
+  } else {
+    traceEventRing[(traceEventHead + traceEventCount) % TRACE_EVENT_RING_CAPACITY] = event
+    traceEventCount += 1
+  }
+}
+
+/** 开始一个 span，返回结束函数；结束时把耗时计入聚合与导出环。 */
+export function startSpan(category: string, name: string): () => void {
+  const startedAt = performance.now()
+  let ended = false
+  return () => {
+    if (ended) return
+    ended = true
+    recordSpan(category, name, performance.now() - startedAt)
+  }
+}
+
+export function recordEventLoopLag(target: string, lagMs: number): void {
+  const value = Number.isFinite(lagMs) ? Math.max(0, lagMs) : 0
+  let aggregate = lagAggregates.get(target)
+  if (!aggregate) {
+    aggregate = { maxMs: 0, recent: [], recentPos: 0, sampleCount: 0 }
+    lagAggregates.set(target, aggregate)
+  }
+  aggregate.sampleCount += 1
+  if (value > aggregate.maxMs) aggregate.maxMs = value
+  aggregate.recentPos = pushSample(aggregate.recent, aggregate.recentPos, value, LAG_SAMPLE_WINDOW)
+}
+
+/**
+ * 事件循环卡顿采样：定时器理论间隔与实际触发时刻之差即主线程被阻塞的时长。
+ * 返回停止函数；定时器 unref，不阻止进程退出。
+ */
+export function startEventLoopLagSampler(
+  target: string,
+  intervalMs: number = DEFAULT_LAG_SAMPLE_INTERVAL_MS,
+): () => void {
+  let expectedAt = performance.now() + intervalMs
+  const timer = setInterval(() => {
+    const now = performance.now()
+    recordEventLoopLag(target, now - expectedAt)
+    expectedAt = now + intervalMs
+  }, intervalMs)
+  ;(timer as unknown as { unref?: () => void }).unref?.()
+  return () => clearInterval(timer)
+}
+
+export function getTraceSnapshot(): TraceSnapshot {
+  const spans: TraceSpanStat[] = []
+  for (const aggregate of spanAggregates.values()) {
+    const sorted = [...aggregate.recent].sort((a, b) => a - b)
+    spans.push({
+      category: aggregate.category,
+      name: aggregate.name,
+      count: aggregate.count,
+      totalMs: aggregate.totalMs,
+      maxMs: aggregate.maxMs,
+      p50Ms: percentile(sorted, 0.5),
+      p99Ms: percentile(sorted, 0.99),
+    })
+  }
+  spans.sort((a, b) => b.p99Ms - a.p99Ms)
+
+  const eventLoop: TraceLagStat[] = []
+  for (const [target, aggregate] of lagAggregates) {
+    const sorted = [...aggregate.recent].sort((a, b) => a - b)
+    eventLoop.push({
+      target,
+      samples: aggregate.sampleCount,
+      p50Ms: percentile(sorted, 0.5),
+      p99Ms: percentile(sorted, 0.99),
+      maxMs: aggregate.maxMs,
+    })
+  }
+  eventLoop.sort((a, b) => a.target.localeCompare(b.target))
+
+  return { startedAt: tracingStartedAt, spans, eventLoop }
+}
+
+/** 导出最近的 span 为 Chrome trace 事件格式 JSON（chrome://tracing / Perfetto）。 */
+export function exportChromeTrace(): string {
+  const traceEvents: Array<Record<string, unknown>> = []
+  for (let i = 0; i < traceEventCount; i++) {
+    const event = traceEventRing[(traceEventHead + i) % TRACE_EVENT_RING_CAPACITY]
+    if (!event) continue
+    traceEvents.push({
+      name: event.name,
+      cat: event.cat,
+      ph: 'X',
+      ts: event.ts,
+      dur: event.dur,
+      pid: process.pid,
+      tid: 0,
+    })
+  }
+  return JSON.stringify({ traceEvents, displayTimeUnit: 'ms' })
+}
+
+/** 仅供测试：清空所有聚合与导出环。 */
+export function resetTracingForTests(): void {
+  spanAggregates.clear()
+  lagAggregates.clear()
+  traceEventRing.fill(null)
+  traceEventHead = 0
+  traceEventCount = 0
+}
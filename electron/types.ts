@@ -95,11 +95,15 @@ export type McpServerConfig = {
   args: string[]
   cwd?: string
   env?: Record<string, string>
+  // true = 应用启动即拉起并常驻（热服务器）；默认懒启动：首次工具调用才 spawn
+  warm?: boolean
 }
 
 export type McpSettings = {
   enabled: boolean
   servers: McpServerConfig[]
+  // 懒启动服务器空闲多少分钟后自动停止（默认 5；warm 服务器不受影响）
+  idleStopMinutes?: number
 }
 
 export type McpServerStatus = 'disconnected' | 'connecting' | 'connected' | 'error'
@@ -785,12 +789,65 @@ export type MemoryRetrieveResult = {
     vector?: {
       enabled: boolean
       attempted: boolean
+      earlyExit?: boolean // 向量腿提前高置信度落地，tag/KG 扩展腿被跳过
       reason?: string
       error?: string
     }
   }
 }
 
+// =========================
+// Semantic Groups (语义组)
+// =========================
+
+export type SemanticGroup = {
+  name: string
+  words: string[]
+  autoLearned: string[] // 自学习词元（与 words 一起参与匹配/向量计算）
+  weight: number
+  vectorId: string | null
+  wordsHash: string | null
+  lastActivatedAt: number | null
+  activationCount: number
+  createdAt: number
+  updatedAt: number
+}
+
+export type SemanticGroupSummary = {
+  name: string
+  wordCount: number
+  autoLearnedCount: number
+  weight: number
+  hasVector: boolean
+  activationCount: number
+  lastActivatedAt: number | null
+}
+
+export type SemanticGroupActivation = {
+  groupName: string
+  strength: number // 匹配词数 / 组词元总数
+  matchedWords: string[]
+}
+
+export type SemanticGroupCreateArgs = {
+  name: string
+  words: string[]
+  weight?: number
+}
+
+export type SemanticGroupUpdateArgs = {
+  name: string
+  words?: string[]
+  autoLearned?: string[]
+  weight?: number
+}
+
+export type SemanticGroupLearnedWord = {
+  word: string
+  count: number
+  lastSeenAt: number | null
+}
+
 // =========================
 // Task / Orchestrator (M1)
 // =========================
@@ -1,7 +1,10 @@
-// 向量检索工作线程：embedding 余弦评分在独立线程进行，避免 better-sqlite3 同步扫描阻塞主进程。
+// 向量检索工作线程：embedding 评分在独立线程进行，避免 better-sqlite3 同步扫描阻塞主进程。
+// 大库走 IVF 近似索引（持久化在 SQLite 文件旁，按 updated_at 水位线增量更新），小库保留精确线性扫描。
 // 评分阶段只取 rowid/created_at/embedding（不取 content），topK 确定后由主进程按 rowid 回表取内容。
+import fs from 'node:fs'
 import { createRequire } from 'node:module'
 import { parentPort, workerData } from 'node:worker_threads'
+import { MemoryAnnIndex, type AnnEntry } from './memory/memoryAnnIndex'
 
 type DatabaseHandle = import('better-sqlite3').Database
 
@@ -22,9 +25,15 @@ export type VectorSearchResponse =
   | { id: number; hits: VectorSearchHit[] }
   | { id: number; error: string }
 
+// 低于该规模时线性扫描已足够快，建索引反而增加开销
+const ANN_MIN_ROWS = 4096
+
 const dbPath = String((workerData as { dbPath?: string } | undefined)?.dbPath ?? '')
+const annIndexPath = dbPath ? `${dbPath}.ann` : ''
 
 let db: DatabaseHandle | null = null
+let annIndex: MemoryAnnIndex | null = null
+let annIndexLoadAttempted = false
 
 function openDb(): DatabaseHandle {
   if (db) return db
@@ -39,7 +48,120 @@ function openDb(): DatabaseHandle {
   return db
 }
 
-function search(req: VectorSearchRequest): VectorSearchHit[] {
+type EmbeddingRow = {
+  rowid: number
+  personaId: string | null
+  createdAt: number
+  status: string | null
+  embedding: Buffer
+}
+
+function rowToEntry(row: EmbeddingRow, dims: number): AnnEntry | null {
+  const buf = row.embedding
+  if (!buf || Math.floor(buf.byteLength / 4) !== dims) return null
+  return {
+    rowid: row.rowid,
+    personaId: row.personaId,
+    createdAt: row.createdAt,
+    // 复制出独立的 Float32Array，避免长期持有 better-sqlite3 返回的 Buffer 底层内存
+    vec: Float32Array.from(new Float32Array(buf.buffer, buf.byteOffset, dims)),
+  }
+}
+
+/** 保证索引与 memory_embedding 同步；返回 null 表示本次走线性扫描。 */
+function ensureAnnIndex(model: string, dims: number): MemoryAnnIndex | null {
+  const stats = openDb()
+    .prepare(
+      `
+      SELECT
+        COUNT(*) as count,
+        COALESCE(MAX(CASE WHEN m.updated_at > e.updated_at THEN m.updated_at ELSE e.updated_at END), 0) as maxUpdated
+      FROM memory_embedding e
+      JOIN memory m ON m.rowid = e.memory_rowid
+      WHERE e.model = ?
+      `,
+    )
+    .get(model) as { count: number; maxUpdated: number }
+  if (stats.count < ANN_MIN_ROWS) return null
+
+  if (!annIndex && !annIndexLoadAttempted && annIndexPath) {
+    annIndexLoadAttempted = true
+    try {
+      if (fs.existsSync(annIndexPath)) annIndex = MemoryAnnIndex.deserialize(fs.readFileSync(annIndexPath))
+    } catch {
+      annIndex = null
+    }
+  }
+
+  let mutated = false
+  if (!annIndex || annIndex.model !== model || annIndex.dims !== dims) {
+    const rows = openDb()
+      .prepare(
+        `
+        SELECT e.memory_rowid as rowid, m.persona_id as personaId, m.created_at as createdAt, m.status as status, e.embedding as embedding
+        FROM memory_embedding e
+        JOIN memory m ON m.rowid = e.memory_rowid
+        WHERE e.model = ? AND COALESCE(m.status, 'active') <> 'deleted'
+        `,
+      )
+      .all(model) as EmbeddingRow[]
+    const entries: AnnEntry[] = []
+    for (const row of rows) {
+      const entry = rowToEntry(row, dims)
+      if (entry) entries.push(entry)
+    }
+    annIndex = MemoryAnnIndex.build(model, dims, entries)
+    annIndex.watermark = stats.maxUpdated
+    mutated = true
+  } else if (stats.maxUpdated > annIndex.watermark) {
+    const rows = openDb()
+      .prepare(
+        `
+        SELECT e.memory_rowid as rowid, m.persona_id as personaId, m.created_at as createdAt, m.status as status, e.embedding as embedding
+        FROM memory_embedding e
+        JOIN memory m ON m.rowid = e.memory_rowid
+        WHERE e.model = ? AND (e.updated_at > ? OR m.updated_at > ?)
+        `,
+      )
+      .all(model, annIndex.watermark, annIndex.watermark) as EmbeddingRow[]
+    for (const row of rows) {
+      annIndex.remove(row.rowid)
+      if ((row.status ?? 'active') === 'deleted') continue
+      const entry = rowToEntry(row, dims)
+      if (entry) annIndex.insert(entry)
+    }
+    annIndex.watermark = stats.maxUpdated
+    mutated = rows.length > 0 || mutated
+  }
+
+  // 物理删除（ON DELETE CASCADE）不更新水位线，只能靠行数对账后剔除失效 rowid
+  if (annIndex.size > stats.count) {
+    const live = new Set(
+      (openDb().prepare('SELECT memory_rowid as rowid FROM memory_embedding WHERE model = ?').all(model) as Array<{
+        rowid: number
+      }>).map((row) => row.rowid),
+    )
+    for (const rowid of annIndex.rowids()) {
+      if (!live.has(rowid)) {
+        annIndex.remove(rowid)
+        mutated = true
+      }
+    }
+  }
+
+  if (mutated && annIndexPath) {
+    try {
+      const tmpPath = `${annIndexPath}.tmp`
+      fs.writeFileSync(tmpPath, annIndex.serialize())
+      fs.renameSync(tmpPath, annIndexPath)
+    } catch {
+      // 持久化失败不影响本次检索，下次启动退化为全量重建
+    }
+  }
+  return annIndex
+}
+
+function linearSearch(req: VectorSearchRequest): VectorSearchHit[] {
   const q = req.query
   const rows = openDb()
     .prepare(
@@ -80,6 +202,23 @@ function search(req: VectorSearchRequest): VectorSearchHit[] {
   return scored.slice(0, req.topK).map((r) => ({ rowid: r.rowid, sim: r.sim }))
 }
 
+function search(req: VectorSearchRequest): VectorSearchHit[] {
+  try {
+    const index = ensureAnnIndex(req.model, req.query.length)
+    if (index) {
+      return index.search(req.query, {
+        personaId: req.personaId,
+        includeShared: req.includeShared,
+        topK: req.topK,
+        minScore: req.minScore,
+      })
+    }
+  } catch {
+    annIndex = null
+  }
+  return linearSearch(req)
+}
+
 parentPort?.on('message', (req: VectorSearchRequest) => {
   let resp: VectorSearchResponse
   try {
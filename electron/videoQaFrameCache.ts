@@ -0,0 +1,120 @@
+// 视频问答抽帧缓存：同一个视频通常会被连续追问好几轮，但抽帧（cv2 解码 +
+// 逐帧写盘）只和视频内容与采样参数有关，和问题无关。这里把抽帧结果按
+// （视频内容哈希, 采样配置）落盘缓存，命中时完全跳过 Python 抽帧脚本。
+import { createHash } from 'node:crypto'
+import * as fs from 'node:fs/promises'
+import * as path from 'node:path'
+
+// 采样哈希每段读取的字节数：对 GB 级视频做全量 sha256 本身就要好几秒，
+// 取 size + 头/中/尾各 1MB 足以区分真实视频文件
+const HASH_SAMPLE_BYTES = 1024 * 1024
+
+export type VideoQaSamplingConfig = {
+  segmentSeconds: number
+  framesPerSegment: number
+  maxSegments: number
+  startSeconds: number
+}
+
+export type VideoQaFrameExtraction = {
+  durationSec: number
+  fps: number
+  segments: Array<{ index: number; startSec: number; endSec: number; frames: string[] }>
+}
+
+type VideoQaCacheMeta = {
+  version: 1
+  durationSec: number
+  fps: number
+  // frames 存相对缓存目录的文件名，缓存目录整体可迁移
+  segments: Array<{ index: number; startSec: number; endSec: number; frames: string[] }>
+  cachedAt: number
+}
+
+export async function videoContentHash(videoPath: string): Promise<string> {
+  const handle = await fs.open(videoPath, 'r')
+  try {
+    const stat = await handle.stat()
+    const size = stat.size
+    const hash = createHash('sha256')
+    hash.update(String(size))
+
+    const offsets = [0, Math.max(0, Math.trunc(size / 2) - Math.trunc(HASH_SAMPLE_BYTES / 2)), Math.max(0, size - HASH_SAMPLE_BYTES)]
+    const buf = Buffer.alloc(HASH_SAMPLE_BYTES)
+    let prevEnd = -1
+    for (const offset of offsets) {
+      // 小文件时采样窗口会重叠，跳过已覆盖的区间
+      const start = Math.max(offset, prevEnd)
+      const length = Math.min(HASH_SAMPLE_BYTES - (start - offset), size - start)
+      if (length <= 0) continue
+      const { bytesRead } = await handle.read(buf, 0, length, start)
+      hash.update(bytesRead === buf.length ? buf : buf.subarray(0, bytesRead))
+      prevEnd = start + bytesRead
+    }
+    return hash.digest('hex').slice(0, 24)
+  } finally {
+    await handle.close()
+  }
+}
+
+export function videoQaSamplingKey(config: VideoQaSamplingConfig): string {
+  return `s${config.segmentSeconds}_f${config.framesPerSegment}_m${config.maxSegments}_t${config.startSeconds}`
+}
+
+export class VideoQaFrameCache {
+  private readonly cacheRoot: string
+
+  constructor(options: { cacheRoot: string }) {
+    this.cacheRoot = options.cacheRoot
+  }
+
+  cacheDirFor(contentHash: string, config: VideoQaSamplingConfig): string {
+    return path.join(this.cacheRoot, contentHash, videoQaSamplingKey(config))
+  }
+
+  /** 命中时返回帧路径已还原为绝对路径的抽帧结果；帧文件缺失视为未命中。 */
+  async lookup(contentHash: string, config: VideoQaSamplingConfig): Promise<VideoQaFrameExtraction | null> {
+    const dir = this.cacheDirFor(contentHash, config)
+    let meta: VideoQaCacheMeta
+    try {
+      const raw = await fs.readFile(path.join(dir, 'meta.json'), 'utf8')
+      const parsed = JSON.parse(raw) as VideoQaCacheMeta
+      if (parsed?.version !== 1 || !Array.isArray(parsed.segments)) return null
+      meta = parsed
+    } catch {
+      return null
+    }
+
+    const segments: VideoQaFrameExtraction['segments'] = []
+    for (const seg of meta.segments) {
+      const frames: string[] = []
+      for (const name of Array.isArray(seg?.frames) ? seg.frames : []) {
+        const abs = path.join(dir, path.basename(String(name)))
+        const stat = await fs.stat(abs).catch(() => null)
+        if (!stat?.isFile()) return null
+        frames.push(abs)
+      }
+      segments.push({ index: seg.index, startSec: seg.startSec, endSec: seg.endSec, frames })
+    }
+    return { durationSec: meta.durationSec, fps: meta.fps, segments }
+  }
+
+  /** 把一次成功抽帧的结果登记进缓存（帧文件需已位于对应缓存目录内）。 */
+  async store(contentHash: string, config: VideoQaSamplingConfig, extraction: VideoQaFrameExtraction): Promise<void> {
+    const dir = this.cacheDirFor(contentHash, config)
+    const meta: VideoQaCacheMeta = {
+      version: 1,
+      durationSec: extraction.durationSec,
+      fps: extraction.fps,
+      segments: extraction.segments.map((seg) => ({
+        index: seg.index,
+        startSec: seg.startSec,
+        endSec: seg.endSec,
+        frames: seg.frames.map((frame) => path.basename(frame)),
+      })),
+      cachedAt: Date.now(),
+    }
+    await fs.mkdir(dir, { recursive: true })
+    await fs.writeFile(path.join(dir, 'meta.json'), JSON.stringify(meta), 'utf8')
+  }
+}
@@ -3,6 +3,7 @@ import path from 'node:path'
 import { fileURLToPath, pathToFileURL } from 'node:url'
 import type { DisplayMode, OrbUiState, WindowBounds, WindowType } from './types'
 import { isTrustedApplicationUrl } from './ipcPermissions'
+import { createPetFrameBatcher, type PetFramePayload } from './petFrameChannel'
 import { getSettings, setSettings } from './store'
 import {
   MANAGED_WINDOW_SIZE_POLICIES,
@@ -32,6 +33,13 @@ const ORB_ANIMATION_CLOSE_MS = 320
 // 仅当 orb 窗口处于“面板态”时才持久化 orbWindowBounds，避免 ball/bar 把展开尺寸覆盖掉
 const ORB_PANEL_PERSIST_MIN_H = 240
 
+// 聊天窗口预热：宠物窗口就绪、事件循环安静后把 ChatWindow 以隐藏态提前建好并加载完
+// 渲染包，托盘/热键首次打开从冷建窗口（1.5~2.5s）变成 show+focus。系统可用内存低于
+// 预算时跳过本轮预热并延迟重试，避免在内存紧张的机器上为了省首开时间反而引发换页。
+const CHAT_PREWARM_DELAY_MS = 3_000
+const CHAT_PREWARM_RETRY_MS = 60_000
+const CHAT_PREWARM_MIN_FREE_MEMORY_KB = 512 * 1024
+
 type ClampBoundsOptions = {
   overflowLeftPx?: number
   overflowRightPx?: number
@@ -164,6 +172,12 @@ export class WindowManager {
   // 低频安全看门狗：forward 鼠标钩子在 Windows 上会因特权窗口聚焦、页面刷新等
   // 静默失效（Electron #15376/#33281/#30808），靠它兜底清理残留状态并重新武装钩子。
   private petClickThroughWatchdog: NodeJS.Timeout | null = null
+  // 高频字段（鼠标跟踪目标、穿透探针坐标）合并进按帧冲刷的二进制 'pet:frame' 通道
+  private readonly petFrameBatcher = createPetFrameBatcher((frame) => {
+    const pet = this.getPetWindow()
+    if (!pet || pet.isDestroyed()) return
+    pet.webContents.send('pet:frame', frame)
+  })
 
   private orbOverlayBaseBounds: Electron.Rectangle | null = null
   // 记住 ball 状态时的位置，以便从 bar/panel 返回时恢复到原位
@@ -176,12 +190,54 @@ export class WindowManager {
   private orbAnimationTimer: NodeJS.Timeout | null = null
   private orbAnimationToken = 0
 
+  private chatPrewarmTimer: NodeJS.Timeout | null = null
+
   constructor(deps: CreateWindowDeps) {
     this.deps = deps
   }
 
   setAppQuitting(quitting: boolean): void {
     this.appQuitting = quitting
+    if (quitting && this.chatPrewarmTimer) {
+      clearTimeout(this.chatPrewarmTimer)
+      this.chatPrewarmTimer = null
+    }
+    if (quitting) this.petFrameBatcher.close()
+  }
+
+  /** 向宠物窗口推送高频帧字段；同一帧窗口内的多次写入合并为一条二进制消息。 */
+  sendPetFrame(payload: PetFramePayload): void {
+    this.petFrameBatcher.set(payload)
+  }
+
+  /** 在事件循环安静后把聊天窗口以隐藏态预热好；窗口已存在或正在退出时为空操作。 */
+  schedulePrewarmChatWindow(delayMs: number = CHAT_PREWARM_DELAY_MS): void {
+    if (this.appQuitting || this.chatPrewarmTimer) return
+    if (this.chatWindow && !this.chatWindow.isDestroyed()) return
+    this.chatPrewarmTimer = setTimeout(() => {
+      this.chatPrewarmTimer = null
+      this.prewarmChatWindow()
+    }, delayMs)
+    ;(this.chatPrewarmTimer as unknown as { unref?: () => void }).unref?.()
+  }
+
+  private prewarmChatWindow(): void {
+    if (this.appQuitting) return
+    if (this.chatWindow && !this.chatWindow.isDestroyed()) return
+    if (!this.hasMemoryBudgetForPrewarm()) {
+      this.schedulePrewarmChatWindow(CHAT_PREWARM_RETRY_MS)
+      return
+    }
+    this.ensureChatWindow({ show: false, focus: false })
+  }
+
+  private hasMemoryBudgetForPrewarm(): boolean {
+    try {
+      return process.getSystemMemoryInfo().free >= CHAT_PREWARM_MIN_FREE_MEMORY_KB
+    } catch (_) {
+      // 拿不到内存信息时不阻止预热（预热失败的代价只是退回冷启动路径）
+      return true
+    }
   }
 
   getAllWindows(): BrowserWindow[] {
@@ -344,6 +400,11 @@ export class WindowManager {
       return this.chatWindow
     }
 
+    if (this.chatPrewarmTimer) {
+      clearTimeout(this.chatPrewarmTimer)
+      this.chatPrewarmTimer = null
+    }
+
     const settings = getSettings()
     const bounds = getBounds('chat')
     const minimum = getEffectiveMinimumSize('chat', bounds)
@@ -390,6 +451,19 @@ export class WindowManager {
       }
     })
 
+    // 预热池语义：窗口在隐藏停驻期间渲染进程崩溃的话，销毁残骸并重新排程预热，
+    // 保证用户点开时拿到的是健康实例；可见窗口的崩溃仍走全局 render-process-gone 日志。
+    win.webContents.on('render-process-gone', (_event, details) => {
+      if (details.reason === 'clean-exit' || this.appQuitting) return
+      if (win.isDestroyed() || win.isVisible()) return
+      try {
+        win.destroy()
+      } catch (_) {
+        /* ignore */
+      }
+      this.schedulePrewarmChatWindow()
+    })
+
     this.attachPersistHandlers(win, 'chat')
     this.attachManagedWindowInputHandlers(win)
     this.loadWindow(win, 'chat')
@@ -1148,7 +1222,7 @@ export class WindowManager {
       return
     }
 
-    pet.webContents.send('pet:cursorProbe', { x: pos.x - b.x, y: pos.y - b.y })
+    this.sendPetFrame({ cursorProbe: { x: pos.x - b.x, y: pos.y - b.y } })
   }
 
   // 事件驱动：由渲染进程的像素命中上报（setPetModelHover）、浮层 hover、拖拽状态触发，
@@ -88,18 +88,93 @@ async function fileToDataUrl(filePath) {
 function l2Normalize(vec) {
   let sumSq = 0
   for (let i = 0; i < vec.length; i += 1) sumSq += vec[i] * vec[i]
-  if (!Number.isFinite(sumSq) || sumSq <= 0) return vec
+  if (!Number.isFinite(sumSq) || sumSq <= 0) return vec instanceof Float32Array ? vec : Float32Array.from(vec)
   const inv = 1 / Math.sqrt(sumSq)
   const out = new Float32Array(vec.length)
   for (let i = 0; i < vec.length; i += 1) out[i] = vec[i] * inv
   return out
 }
 
-function dot(a, b) {
-  const n = Math.min(a.length, b.length)
-  let s = 0
-  for (let i = 0; i < n; i += 1) s += a[i] * b[i]
-  return s
+// 对连续存储的向量行做批量点积：4 路展开打破累加依赖链，让 V8 能流水/向量化，
+// 整体吞吐受内存带宽而不是标量循环开销限制。
+function scoreRowsInto(slab, rowCount, dim, query, out) {
+  for (let row = 0; row < rowCount; row += 1) {
+    const base = row * dim
+    let s0 = 0
+    let s1 = 0
+    let s2 = 0
+    let s3 = 0
+    let i = 0
+    const limit = dim - 3
+    for (; i < limit; i += 4) {
+      const o = base + i
+      s0 += slab[o] * query[i]
+      s1 += slab[o + 1] * query[i + 1]
+      s2 += slab[o + 2] * query[i + 2]
+      s3 += slab[o + 3] * query[i + 3]
+    }
+    for (; i < dim; i += 1) s0 += slab[base + i] * query[i]
+    out[row] = s0 + s1 + s2 + s3
+  }
+}
+
+// 固定容量的小顶堆：取 topK 只需 O(n log k) 且不为落选项分配对象。
+class BoundedTopK {
+  constructor(capacity) {
+    this.capacity = capacity
+    this.size = 0
+    this.scores = new Float64Array(capacity)
+    this.indices = new Int32Array(capacity)
+  }
+
+  offer(index, score) {
+    if (this.size < this.capacity) {
+      let i = this.size
+      this.size += 1
+      this.scores[i] = score
+      this.indices[i] = index
+      while (i > 0) {
+        const parent = (i - 1) >> 1
+        if (this.scores[parent] <= this.scores[i]) break
+        this.swap(i, parent)
+        i = parent
+      }
+      return
+    }
+    if (score <= this.scores[0]) return
+    this.scores[0] = score
+    this.indices[0] = index
+    this.siftDown(0)
+  }
+
+  siftDown(i) {
+    for (;;) {
+      const left = i * 2 + 1
+      if (left >= this.size) return
+      const right = left + 1
+      let min = left
+      if (right < this.size && this.scores[right] < this.scores[left]) min = right
+      if (this.scores[i] <= this.scores[min]) return
+      this.swap(i, min)
+      i = min
+    }
+  }
+
+  swap(a, b) {
+    const s = this.scores[a]
+    this.scores[a] = this.scores[b]
+    this.scores[b] = s
+    const idx = this.indices[a]
+    this.indices[a] = this.indices[b]
+    this.indices[b] = idx
+  }
+
+  drainDescending() {
+    const out = []
+    for (let i = 0; i < this.size; i += 1) out.push({ idx: this.indices[i], score: this.scores[i] })
+    out.sort((a, b) => b.score - a.score)
+    return out
+  }
 }
 
 class SimpleIndex {
@@ -107,52 +182,79 @@ class SimpleIndex {
     const dataDir = String(opts?.dataDir ?? '').trim()
     this.dataDir = dataDir || path.join(process.cwd(), 'mcp-output', 'mmvector')
     this.indexFile = path.join(this.dataDir, 'index.json')
+    // 向量单独存成紧凑的 float32 二进制（row-major），加载/检索都零解析开销；
+    // index.json 只保留元数据。
+    this.vectorFile = path.join(this.dataDir, 'embeddings.f32')
     this.dim = 0
     this.items = []
-    this.embeddings = []
+    this.slab = new Float32Array(0)
+    this.scoreBuf = new Float64Array(0)
   }
 
   async ensureDir() {
     await fs.mkdir(this.dataDir, { recursive: true })
   }
 
+  reset() {
+    this.dim = 0
+    this.items = []
+    this.slab = new Float32Array(0)
+    this.scoreBuf = new Float64Array(0)
+  }
+
   async load() {
     await this.ensureDir()
     try {
       const raw = await fs.readFile(this.indexFile, 'utf8')
       const parsed = JSON.parse(raw)
       const items = Array.isArray(parsed?.items) ? parsed.items : []
-      const embeddings = Array.isArray(parsed?.embeddings) ? parsed.embeddings : []
       const dim = clampInt(parsed?.dim, 0, 0, 1_000_000)
-      if (!dim || items.length !== embeddings.length) {
-        this.dim = 0
-        this.items = []
-        this.embeddings = []
+      if (!dim || items.length === 0) {
+        this.reset()
+        return
+      }
+
+      // 旧格式（version 1）把向量内联在 JSON 里；读到后迁移为二进制。
+      const legacy = Array.isArray(parsed?.embeddings) ? parsed.embeddings : null
+      if (legacy) {
+        if (legacy.length !== items.length) {
+          this.reset()
+          return
+        }
+        this.dim = dim
+        this.items = items
+        this.slab = new Float32Array(items.length * dim)
+        for (let i = 0; i < legacy.length; i += 1) {
+          const arr = Array.isArray(legacy[i]) ? legacy[i] : []
+          if (arr.length !== dim) continue
+          for (let j = 0; j < dim; j += 1) {
+            const x = arr[j]
+            this.slab[i * dim + j] = typeof x === 'number' ? x : Number(x) || 0
+          }
+        }
+        await this.save()
+        return
+      }
+
+      const buf = await fs.readFile(this.vectorFile)
+      if (buf.byteLength !== items.length * dim * 4) {
+        this.reset()
         return
       }
       this.dim = dim
       this.items = items
-      this.embeddings = embeddings.map((v) => {
-        const arr = Array.isArray(v) ? v : []
-        const f32 = new Float32Array(arr.map((x) => (typeof x === 'number' ? x : Number(x) || 0)))
-        return f32.length === dim ? f32 : new Float32Array(dim)
-      })
+      this.slab = new Float32Array(buf.buffer.slice(buf.byteOffset, buf.byteOffset + buf.byteLength))
     } catch {
-      this.dim = 0
-      this.items = []
-      this.embeddings = []
+      this.reset()
     }
   }
 
   async save() {
     await this.ensureDir()
-    const payload = {
-      version: 1,
-      dim: this.dim,
-      items: this.items,
-      embeddings: this.embeddings.map((v) => Array.from(v)),
-    }
+    const payload = { version: 2, dim: this.dim, items: this.items }
     await fs.writeFile(this.indexFile, JSON.stringify(payload), 'utf8')
+    const used = this.items.length * this.dim
+    await fs.writeFile(this.vectorFile, Buffer.from(this.slab.buffer, this.slab.byteOffset, used * 4))
   }
 
   count() {
@@ -163,9 +265,7 @@ class SimpleIndex {
   }
 
   async clear() {
-    this.items = []
-    this.embeddings = []
-    this.dim = 0
+    this.reset()
     await this.save()
   }
 
@@ -174,7 +274,8 @@ class SimpleIndex {
     if (idx < 0 || idx >= this.items.length) return null
     const item = this.items[idx]
     this.items.splice(idx, 1)
-    this.embeddings.splice(idx, 1)
+    const dim = this.dim
+    this.slab.copyWithin(idx * dim, (idx + 1) * dim, (this.items.length + 1) * dim)
     // Re-number IDs to keep it stable for UI like app.py demo
     for (let i = 0; i < this.items.length; i += 1) {
       this.items[i].id = i
@@ -188,14 +289,20 @@ class SimpleIndex {
     if (!this.dim) this.dim = vec.length
     if (vec.length !== this.dim) {
       // Dimension changed: reset to avoid mixing incompatible vectors.
-      this.items = []
-      this.embeddings = []
+      this.reset()
       this.dim = vec.length
     }
     const id = this.items.length
+    const needed = (id + 1) * this.dim
+    if (this.slab.length < needed) {
+      // 倍增扩容，摊还掉逐条 append 的拷贝成本
+      const grown = new Float32Array(Math.max(needed, this.slab.length * 2))
+      grown.set(this.slab)
+      this.slab = grown
+    }
+    this.slab.set(vec, id * this.dim)
     const item = { ...meta, id, createdAt: nowBeijingIso() }
     this.items.push(item)
-    this.embeddings.push(vec)
     await this.save()
     return item
   }
@@ -210,21 +317,24 @@ class SimpleIndex {
     const q = l2Normalize(queryVec)
     if (q.length !== this.dim) return []
 
-    const scored = []
-    for (let i = 0; i < this.embeddings.length; i += 1) {
+    const rowCount = this.items.length
+    if (this.scoreBuf.length < rowCount) this.scoreBuf = new Float64Array(rowCount)
+    scoreRowsInto(this.slab, rowCount, this.dim, q, this.scoreBuf)
+
+    const heap = new BoundedTopK(topK)
+    for (let i = 0; i < rowCount; i += 1) {
       const item = this.items[i]
       if (!item) continue
       const type = item.type === 'video' ? 'video' : 'image'
       if (filter === 'image' && type !== 'image') continue
       if (filter === 'video' && type !== 'video') continue
-      const s = dot(q, this.embeddings[i])
+      const s = this.scoreBuf[i]
       if (!Number.isFinite(s)) continue
       if (s < minScore) continue
-      scored.push({ idx: i, score: s })
+      heap.offer(i, s)
     }
 
-    scored.sort((a, b) => b.score - a.score)
-    return scored.slice(0, topK).map((r) => ({ ...this.items[r.idx], score: r.score }))
+    return heap.drainDescending().map((r) => ({ ...this.items[r.idx], score: r.score }))
   }
 }
 
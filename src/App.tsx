@@ -44,6 +44,20 @@ function App() {
     return api.onSettingsChanged(setSettings)
   }, [api, needsSettings])
 
+  // 渲染进程事件循环卡顿采样：定时器理论触发时刻与实际时刻之差即本窗口被阻塞的
+  // 时长，上报主进程聚合后在追踪面板里与主进程卡顿对照，定位"卡了一下"发生在哪侧
+  useEffect(() => {
+    if (!api?.reportEventLoopLag) return
+    const intervalMs = 500
+    let expectedAt = performance.now() + intervalMs
+    const timer = window.setInterval(() => {
+      const now = performance.now()
+      api.reportEventLoopLag(Math.max(0, now - expectedAt))
+      expectedAt = now + intervalMs
+    }, intervalMs)
+    return () => window.clearInterval(timer)
+  }, [api])
+
   let content
 
   if (windowType === 'chat') content = <ChatWindow api={api} />
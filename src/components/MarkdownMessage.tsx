@@ -1,6 +1,7 @@
-import { memo, useEffect, useMemo, useState, type ImgHTMLAttributes } from 'react'
+import { Fragment, memo, useEffect, useMemo, useState, type ImgHTMLAttributes } from 'react'
 import ReactMarkdown, { type Components } from 'react-markdown'
 import remarkGfm from 'remark-gfm'
+import { splitMarkdownBlocks } from '../utils/markdownBlocks'
 import { splitThinkSegments } from '../utils/splitThinkSegments'
 import { getApi } from '../neoDeskPetApi'
 import { peekLocalMediaUrl, resolveLocalMediaUrl } from '../services/localMediaCache'
@@ -71,19 +72,44 @@ function MarkdownImage(props: MarkdownImageProps) {
   return finalSrc ? <img {...rest} className={mergedClassName} src={finalSrc} alt={alt ?? ''} loading="lazy" /> : null
 }
 
+// components/插件引用保持模块级稳定，分块 memo 才能在流式追加时跳过已闭合块
+const markdownComponents: Components = {
+  a: ({ node, ...rest }) => {
+    void node
+    return <a {...rest} target="_blank" rel="noreferrer" />
+  },
+  img: ({ node, ...rest }) => {
+    void node
+    return <MarkdownImage {...rest} />
+  },
+}
+
+const remarkPlugins = [remarkGfm]
+
+// 按顶层块粒度 memo：流式 flush 只改动最后一个未闭合块的文本，
+// 之前的块 props 不变，react-markdown 的重新解析成本因此保持 O(追加量) 而非 O(全文)。
+const MarkdownBlock = memo(function MarkdownBlock(props: { text: string }) {
+  return (
+    <ReactMarkdown
+      remarkPlugins={remarkPlugins}
+      skipHtml
+      components={markdownComponents}
+      urlTransform={markdownMediaUrlTransform}
+    >
+      {props.text}
+    </ReactMarkdown>
+  )
+})
+
+function renderMarkdownBlocks(content: string, keyPrefix: string) {
+  return splitMarkdownBlocks(content).map((block, blockIdx) => (
+    <MarkdownBlock key={`${keyPrefix}-${blockIdx}`} text={block} />
+  ))
+}
+
 function MarkdownMessageInner(props: { text: string; className?: string }) {
   const normalizedText = applyMarkdownLocalImagePathCompat(applyCjkMarkdownCompat(props.text))
   const segments = splitThinkSegments(normalizedText)
-  const components: Components = {
-    a: ({ node, ...rest }) => {
-      void node
-      return <a {...rest} target="_blank" rel="noreferrer" />
-    },
-    img: ({ node, ...rest }) => {
-      void node
-      return <MarkdownImage {...rest} />
-    },
-  }
   return (
     <div className={['ndp-md', props.className].filter(Boolean).join(' ')}>
       {segments.map((seg, idx) => {
@@ -91,31 +117,12 @@ function MarkdownMessageInner(props: { text: string; className?: string }) {
           return (
             <details key={`think-${idx}`} className="ndp-think">
               <summary className="ndp-think-summary">思考过程</summary>
-              <div className="ndp-think-body">
-                <ReactMarkdown
-                  remarkPlugins={[remarkGfm]}
-                  skipHtml
-                  components={components}
-                  urlTransform={markdownMediaUrlTransform}
-                >
-                  {seg.content}
-                </ReactMarkdown>
-              </div>
+              <div className="ndp-think-body">{renderMarkdownBlocks(seg.content, `think-${idx}`)}</div>
             </details>
           )
         }
 
-        return (
-          <ReactMarkdown
-            key={`md-${idx}`}
-            remarkPlugins={[remarkGfm]}
-            skipHtml
-            components={components}
-            urlTransform={markdownMediaUrlTransform}
-          >
-            {seg.content}
-          </ReactMarkdown>
-        )
+        return <Fragment key={`md-${idx}`}>{renderMarkdownBlocks(seg.content, `md-${idx}`)}</Fragment>
       })}
     </div>
   )
@@ -3,9 +3,11 @@
 import { useState, useEffect } from 'react'
 import { getApi } from '../neoDeskPetApi'
 import {
+  LOCAL_MEDIA_PREVIEW_WIDTH,
   buildLocalMediaReference,
   resolveLocalMediaDataUrl,
   resolveLocalMediaUrl,
+  withLocalMediaWidth,
 } from '../services/localMediaCache'
 import { toLocalMediaSrc } from '../utils/chatMessages'
 
@@ -29,7 +31,10 @@ export function MmvectorImagePreview(props: {
       return
     }
     if (!api || !p) return
-    void resolveLocalMediaDataUrl(api, buildLocalMediaReference(p, resourceId))
+    const reference = buildLocalMediaReference(p, resourceId)
+    // 预览优先拿缩略图 URL（千字节级）；媒体服务不可用时再退回整图 data URL
+    void resolveLocalMediaUrl(api, reference)
+      .then((url) => (url ? withLocalMediaWidth(url, LOCAL_MEDIA_PREVIEW_WIDTH) : resolveLocalMediaDataUrl(api, reference)))
       .then((nextSrc) => {
         if (!alive) return
         setResolved({ key: sourceKey, src: nextSrc })
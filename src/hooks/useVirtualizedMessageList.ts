@@ -0,0 +1,181 @@
+import { useEffect, useMemo, useRef, useState, type RefObject } from 'react'
+
+// 消息列表虚拟化：只渲染视口内 + overscan 边距的行，其余用上下占位块撑出滚动高度，
+// 行高进入测量缓存（ResizeObserver 跟踪流式增长/图片加载），未测量行用估计值。
+// 渲染与内存成本因此是 O(视口) 而非 O(会话长度)。
+
+export const DEFAULT_ESTIMATED_ROW_HEIGHT = 96
+export const DEFAULT_OVERSCAN_PX = 600
+const FALLBACK_TAIL_COUNT = 30
+
+export type VirtualizedRange = {
+  startIndex: number
+  endIndex: number
+  topPad: number
+  bottomPad: number
+  totalHeight: number
+}
+
+export function resolveVirtualizedRange(args: {
+  count: number
+  scrollTop: number
+  viewportHeight: number
+  estimatedHeight?: number
+  overscanPx?: number
+  rowGapPx?: number
+  heightAt?: (index: number) => number | undefined
+}): VirtualizedRange {
+  const count = Math.max(0, Math.trunc(args.count))
+  const estimated = Math.max(1, Math.trunc(args.estimatedHeight ?? DEFAULT_ESTIMATED_ROW_HEIGHT))
+  const overscan = Math.max(0, args.overscanPx ?? DEFAULT_OVERSCAN_PX)
+  const rowGap = Math.max(0, args.rowGapPx ?? 0)
+  const heightAt = args.heightAt ?? (() => undefined)
+  if (count === 0) return { startIndex: 0, endIndex: 0, topPad: 0, bottomPad: 0, totalHeight: 0 }
+
+  const offsets = new Array<number>(count + 1)
+  offsets[0] = 0
+  for (let i = 0; i < count; i++) {
+    offsets[i + 1] = offsets[i] + Math.max(1, heightAt(i) ?? estimated) + (i < count - 1 ? rowGap : 0)
+  }
+  const totalHeight = offsets[count]
+
+  // 视口尚未量到高度（首帧/隐藏窗口）时退化为尾部窗口，保证“滚到底部”可立即呈现
+  if (args.viewportHeight <= 0) {
+    const startIndex = Math.max(0, count - FALLBACK_TAIL_COUNT)
+    return { startIndex, endIndex: count, topPad: offsets[startIndex], bottomPad: 0, totalHeight }
+  }
+
+  const viewTop = Math.max(0, args.scrollTop - overscan)
+  const viewBottom = args.scrollTop + args.viewportHeight + overscan
+
+  let startIndex = count
+  for (let i = 0; i < count; i++) {
+    if (offsets[i + 1] > viewTop) {
+      startIndex = i
+      break
+    }
+  }
+  let endIndex = count
+  for (let i = startIndex; i < count; i++) {
+    if (offsets[i] >= viewBottom) {
+      endIndex = i
+      break
+    }
+  }
+
+  return {
+    startIndex,
+    endIndex,
+    topPad: offsets[startIndex],
+    bottomPad: totalHeight - offsets[endIndex],
+    totalHeight,
+  }
+}
+
+export function useVirtualizedMessageList<T>(
+  items: readonly T[],
+  getId: (item: T) => string,
+  scrollRef: RefObject<HTMLElement | null>,
+  resetKey: string,
+  options: { estimatedHeight?: number; overscanPx?: number; rowGapPx?: number } = {},
+) {
+  const estimatedHeight = options.estimatedHeight ?? DEFAULT_ESTIMATED_ROW_HEIGHT
+  const overscanPx = options.overscanPx ?? DEFAULT_OVERSCAN_PX
+  const rowGapPx = options.rowGapPx ?? 0
+  const heightsRef = useRef(new Map<string, number>())
+  const [measureVersion, setMeasureVersion] = useState(0)
+  const [viewport, setViewport] = useState({ scrollTop: 0, height: 0 })
+
+  // 会话切换时清空行高缓存，避免跨会话无限增长
+  useEffect(() => {
+    heightsRef.current.clear()
+  }, [resetKey])
+
+  useEffect(() => {
+    const el = scrollRef.current
+    if (!el) return
+    let frame: number | null = null
+    const sync = () => {
+      frame = null
+      setViewport((prev) => {
+        const next = { scrollTop: el.scrollTop, height: el.clientHeight }
+        return prev.scrollTop === next.scrollTop && prev.height === next.height ? prev : next
+      })
+    }
+    const schedule = () => {
+      if (frame === null) frame = window.requestAnimationFrame(sync)
+    }
+    sync()
+    el.addEventListener('scroll', schedule, { passive: true })
+    window.addEventListener('resize', schedule)
+    return () => {
+      el.removeEventListener('scroll', schedule)
+      window.removeEventListener('resize', schedule)
+      if (frame !== null) window.cancelAnimationFrame(frame)
+    }
+  }, [scrollRef, resetKey])
+
+  // 行高测量：按 data-virtual-row-id 收集渲染中的行，首次直接量 offsetHeight，
+  // 之后交给 ResizeObserver 跟踪（流式输出、图片载入都会改变行高）
+  useEffect(() => {
+    const el = scrollRef.current
+    if (!el) return
+    const rows = Array.from(el.querySelectorAll<HTMLElement>('[data-virtual-row-id]'))
+    let changed = false
+    for (const row of rows) {
+      const id = row.dataset.virtualRowId ?? ''
+      if (!id) continue
+      const height = row.offsetHeight
+      if (height <= 0) continue
+      const previous = heightsRef.current.get(id)
+      if (previous === undefined || Math.abs(previous - height) > 1) {
+        heightsRef.current.set(id, height)
+        changed = true
+      }
+    }
+    if (changed) setMeasureVersion((version) => version + 1)
+
+    if (typeof ResizeObserver === 'undefined') return
+    const observer = new ResizeObserver((entries) => {
+      let resized = false
+      for (const entry of entries) {
+        const target = entry.target as HTMLElement
+        const id = target.dataset.virtualRowId ?? ''
+        if (!id) continue
+        const height = target.offsetHeight
+        if (height <= 0) continue
+        const previous = heightsRef.current.get(id)
+        if (previous === undefined || Math.abs(previous - height) > 1) {
+          heightsRef.current.set(id, height)
+          resized = true
+        }
+      }
+      if (resized) setMeasureVersion((version) => version + 1)
+    })
+    for (const row of rows) observer.observe(row)
+    return () => observer.disconnect()
+  })
+
+  const range = useMemo(
+    () =>
+      resolveVirtualizedRange({
+        count: items.length,
+        scrollTop: viewport.scrollTop,
+        viewportHeight: viewport.height,
+        estimatedHeight,
+        overscanPx,
+        rowGapPx,
+        heightAt: (index) => heightsRef.current.get(getId(items[index])),
+      }),
+    // measureVersion 驱动“量到真实行高后”重算占位高度
+    [items, viewport, estimatedHeight, overscanPx, rowGapPx, getId, measureVersion],
+  )
+
+  return {
+    visibleItems: items.slice(range.startIndex, range.endIndex),
+    startIndex: range.startIndex,
+    topPad: range.topPad,
+    bottomPad: range.bottomPad,
+    totalHeight: range.totalHeight,
+  }
+}
@@ -8,6 +8,12 @@ import {
   type Live2dCapabilities,
   type Live2dParamScriptEngine,
 } from './live2dParamTools'
+import {
+  LIVE2D_ACTIVE_FPS,
+  LIVE2D_MOTION_BOOST_MS,
+  LIVE2D_MOUSE_BOOST_MS,
+  resolveLive2dMaxFps,
+} from './live2dRenderMode'
 import { getApi } from '../neoDeskPetApi'
 
 type Props = {
@@ -53,6 +59,15 @@ export function Live2DView(props: Props) {
   const mouseCurrentRef = useRef<{ x: number; y: number }>({ x: 0, y: 0 })
   const mouseResettingRef = useRef(false)
 
+  // 空闲降帧（见 live2dRenderMode.ts）：boostUntil 之前保持全帧率；
+  // markRenderActivity 在事件入口立即拉满帧率，避免等低频 update 才响应
+  const renderBoostUntilRef = useRef(0)
+  const markRenderActivity = (holdMs: number) => {
+    renderBoostUntilRef.current = Math.max(renderBoostUntilRef.current, Date.now() + holdMs)
+    const ticker = appRef.current?.ticker
+    if (ticker && ticker.maxFPS !== LIVE2D_ACTIVE_FPS) ticker.maxFPS = LIVE2D_ACTIVE_FPS
+  }
+
   const lastLayoutRef = useRef<{ w: number; h: number; dpr: number }>({ w: 0, h: 0, dpr: 0 })
   const syncLayoutRef = useRef<(() => void) | null>(null)
 
@@ -63,10 +78,13 @@ export function Live2DView(props: Props) {
 
   useEffect(() => {
     mouthOpenRef.current = Math.max(0, Math.min(1.25, mouthOpen))
+    // TTS 口型同步开始的瞬间拉回满帧率（后续由 update 循环里的 mouthOpen 判定维持）
+    if (mouthOpenRef.current > 0.01) markRenderActivity(LIVE2D_MOUSE_BOOST_MS)
   }, [mouthOpen])
 
   useEffect(() => {
     windowDraggingRef.current = windowDragging
+    if (windowDragging) markRenderActivity(LIVE2D_MOUSE_BOOST_MS)
   }, [windowDragging])
 
   useEffect(() => {
@@ -74,6 +92,7 @@ export function Live2DView(props: Props) {
     if (!mouseTrackingEnabledRef.current) {
       mouseTargetRef.current = { x: 0, y: 0 }
       mouseResettingRef.current = true
+      markRenderActivity(LIVE2D_MOUSE_BOOST_MS)
 
       const accessor = paramAccessorRef.current
       if (accessor) {
@@ -121,8 +140,8 @@ export function Live2DView(props: Props) {
 
     try {
       const ticker = app.ticker
-      if (ticker && (ticker.maxFPS === 0 || ticker.maxFPS > 30)) {
-        ticker.maxFPS = 30
+      if (ticker && (ticker.maxFPS === 0 || ticker.maxFPS > LIVE2D_ACTIVE_FPS)) {
+        ticker.maxFPS = LIVE2D_ACTIVE_FPS
       }
     } catch {
       // ignore
@@ -240,6 +259,7 @@ export function Live2DView(props: Props) {
             const allowControl = !windowDraggingRef.current
             const trackingEnabled = mouseTrackingEnabledRef.current
             const resetting = !trackingEnabled && mouseResettingRef.current
+            let mouseSettled = true
 
             if (allowControl) {
               const target = mouseTargetRef.current
@@ -250,6 +270,7 @@ export function Live2DView(props: Props) {
 
               cur.x = cur.x + (tx - cur.x) * k
               cur.y = cur.y + (ty - cur.y) * k
+              mouseSettled = Math.abs(tx - cur.x) < 0.002 && Math.abs(ty - cur.y) < 0.002
 
               setParam('ParamAngleX', cur.x * 30)
               setParam('ParamAngleY', -cur.y * 30)
@@ -278,6 +299,18 @@ export function Live2DView(props: Props) {
               setParam('ParamBodyAngleY', Math.sin(physicsTime * 0.8) * 1.5)
             }
             setParam('ParamMouthOpenY', mouthOpenRef.current)
+
+            // 按当帧活动状态调整 ticker 上限：空闲降到低帧率，有活动立即回满帧
+            const targetFps = resolveLive2dMaxFps({
+              dragging: windowDraggingRef.current,
+              mouthOpen: mouthOpenRef.current,
+              scriptRunning: scriptEngineRef.current?.isRunning() ?? false,
+              mouseSettled,
+              boostUntil: renderBoostUntilRef.current,
+              now: Date.now(),
+            })
+            const ticker = appRef.current?.ticker
+            if (ticker && ticker.maxFPS !== targetFps) ticker.maxFPS = targetFps
           }
         }
       } catch {
@@ -323,6 +356,7 @@ export function Live2DView(props: Props) {
       const x = typeof payload?.x === 'number' && Number.isFinite(payload.x) ? payload.x : 0
       const y = typeof payload?.y === 'number' && Number.isFinite(payload.y) ? payload.y : 0
       mouseTargetRef.current = { x: clamp(x, -1, 1), y: clamp(y, -1, 1) }
+      markRenderActivity(LIVE2D_MOUSE_BOOST_MS)
     })
   }, [])
 
@@ -424,6 +458,7 @@ export function Live2DView(props: Props) {
     const unsubExpression = api.onLive2dExpression((expressionName) => {
       const model = modelRef.current
       if (!model) return
+      markRenderActivity(LIVE2D_MOTION_BOOST_MS)
       try {
         model.expression(expressionName)
       } catch (err) {
@@ -434,6 +469,7 @@ export function Live2DView(props: Props) {
     const unsubMotion = api.onLive2dMotion((motionGroup, index) => {
       const model = modelRef.current
       if (!model) return
+      markRenderActivity(LIVE2D_MOTION_BOOST_MS)
       try {
         model.motion(motionGroup, index)
       } catch (err) {
@@ -453,7 +489,9 @@ export function Live2DView(props: Props) {
       const res = engine.enqueue(payload)
       if (!res.ok) {
         console.warn('[Live2D] Param script rejected:', res.error ?? 'unknown')
+        return
       }
+      markRenderActivity(LIVE2D_MOUSE_BOOST_MS)
     })
 
     return () => {
@@ -67,6 +67,16 @@ export type Live2dParamAccessor = {
   listParameters: () => Live2dParameterInfo[]
 }
 
+// 每模型编译一次的参数表：字符串 ID → 核心数值索引，min/max/def 一并烘焙成
+// typed array。TTS 口型同步 + 表情混合时 set/get 每秒运行数百次，命中表后
+// 按索引读写，热路径上不再做字符串哈希，也不再向核心重查取值范围。
+type CompiledParamTable = {
+  indexById: Map<string, number>
+  min: Float32Array
+  max: Float32Array
+  infos: Live2dParameterInfo[]
+}
+
 export function createLive2dParamAccessor(model: Live2DModel): Live2dParamAccessor {
   const internalModel = model.internalModel as unknown as { coreModel?: Record<string, unknown> }
   const core = internalModel?.coreModel as Record<string, unknown> | undefined
@@ -82,75 +92,36 @@ export function createLive2dParamAccessor(model: Live2DModel): Live2dParamAccess
     }
   }
 
-  const set = (id: string, value: number) => {
-    if (!core) return
-    const paramId = String(id ?? '').trim()
-    if (!paramId) return
-
-    // Cubism4 (preferred)
-    const setById = core.setParameterValueById
-    if (typeof setById === 'function') {
-      safeCoreCall<void>(setById, [paramId, value], undefined)
-      return
-    }
+  const buildTable = (): CompiledParamTable => {
+    const empty: CompiledParamTable = { indexById: new Map(), min: new Float32Array(0), max: new Float32Array(0), infos: [] }
+    if (!core) return empty
 
-    // Cubism2 fallback
-    const setParamFloat = core.setParamFloat
-    if (typeof setParamFloat === 'function') safeCoreCall<void>(setParamFloat, [toCubism2ParamName(paramId), value], undefined)
-  }
-
-  const get = (id: string): number => {
-    if (!core) return Number.NaN
-    const paramId = String(id ?? '').trim()
-    if (!paramId) return Number.NaN
-
-    const getById = core.getParameterValueById
-    if (typeof getById === 'function') {
-      const v = safeCoreCall<unknown>(getById, [paramId], Number.NaN)
-      return typeof v === 'number' && Number.isFinite(v) ? v : Number.NaN
-    }
-
-    const getParamFloat = core.getParamFloat
-    if (typeof getParamFloat === 'function') {
-      const v = safeCoreCall<unknown>(getParamFloat, [toCubism2ParamName(paramId)], Number.NaN)
-      return typeof v === 'number' && Number.isFinite(v) ? v : Number.NaN
-    }
-
-    return Number.NaN
-  }
-
-  const listParameters = (): Live2dParameterInfo[] => {
-    if (!core) return []
-
-    // Cubism4: getters by index
     const getCount = core.getParameterCount
     const getIdAt = core.getParameterId
     const getMinAt = core.getParameterMinimumValue
     const getMaxAt = core.getParameterMaximumValue
     const getDefAt = core.getParameterDefaultValue
 
+    // ID 列举来源按可用性排序；三条路径里 i 都是核心的真实参数索引
+    let ids: Array<{ index: number; id: string }> = []
+    let arrayMins: unknown[] | null = null
+    let arrayMaxs: unknown[] | null = null
+    let arrayDefs: unknown[] | null = null
+
+    // Cubism4: getters by index
     if (typeof getCount === 'function' && typeof getIdAt === 'function') {
       const count = safeCoreCall<number>(getCount, [], 0)
-      const out: Live2dParameterInfo[] = []
       for (let i = 0; i < (typeof count === 'number' ? count : 0); i += 1) {
-        const rawId = safeCoreCall<unknown>(getIdAt, [i], '')
-        const id = normalizeParamId(rawId)
-        if (!id) continue
-        out.push({
-          id,
-          min: clampNumber(safeCoreCall(getMinAt, [i], Number.NaN)),
-          max: clampNumber(safeCoreCall(getMaxAt, [i], Number.NaN)),
-          def: clampNumber(safeCoreCall(getDefAt, [i], Number.NaN)),
-        })
+        const id = normalizeParamId(safeCoreCall<unknown>(getIdAt, [i], ''))
+        if (id) ids.push({ index: i, id })
       }
-      if (out.length > 0) return out
     }
 
     // Cubism4 (pixi-live2d-display 0.4.x): no getParameterId(), but has internal arrays:
     // - core._parameterIds (string[] or id handles)
     // - core._model.parameters.ids (id handles)
     // 这里尽量用公开 getter 取 min/max/def，用内部 ids 仅作为“列举 ID”
-    if (typeof getCount === 'function') {
+    if (ids.length === 0 && typeof getCount === 'function') {
       const count = safeCoreCall<number>(getCount, [], 0)
       const coreAny = core as unknown as {
         _parameterIds?: unknown
@@ -163,52 +134,147 @@ export function createLive2dParamAccessor(model: Live2DModel): Live2dParamAccess
         null
 
       if (idsRaw && idsRaw.length > 0) {
-        const out: Live2dParameterInfo[] = []
         const lim = typeof count === 'number' && count > 0 ? Math.min(count, idsRaw.length) : idsRaw.length
         for (let i = 0; i < lim; i += 1) {
           const id = normalizeParamId(idsRaw[i])
-          if (!id) continue
-          out.push({
-            id,
-            min: clampNumber(safeCoreCall(getMinAt, [i], Number.NaN)),
-            max: clampNumber(safeCoreCall(getMaxAt, [i], Number.NaN)),
-            def: clampNumber(safeCoreCall(getDefAt, [i], Number.NaN)),
-          })
+          if (id) ids.push({ index: i, id })
         }
-        if (out.length > 0) return out
       }
     }
 
     // Cubism4: parameters.* arrays (some builds)
-    const params = core.parameters as unknown
-    if (params && typeof params === 'object' && !Array.isArray(params)) {
-      const p = params as Record<string, unknown>
-      const ids = Array.isArray(p.ids) ? (p.ids as unknown[]) : []
-      const mins = Array.isArray(p.minimumValues) ? (p.minimumValues as unknown[]) : []
-      const maxs = Array.isArray(p.maximumValues) ? (p.maximumValues as unknown[]) : []
-      const defs = Array.isArray(p.defaultValues)
-        ? (p.defaultValues as unknown[])
-        : Array.isArray(p.values)
-          ? (p.values as unknown[])
-          : []
-
-      const out: Live2dParameterInfo[] = []
-      for (let i = 0; i < ids.length; i += 1) {
-        const id = normalizeParamId(ids[i])
-        if (!id) continue
-        out.push({
-          id,
-          min: clampNumber(mins[i]),
-          max: clampNumber(maxs[i]),
-          def: clampNumber(defs[i]),
-        })
+    if (ids.length === 0) {
+      const params = core.parameters as unknown
+      if (params && typeof params === 'object' && !Array.isArray(params)) {
+        const p = params as Record<string, unknown>
+        const idsRaw = Array.isArray(p.ids) ? (p.ids as unknown[]) : []
+        arrayMins = Array.isArray(p.minimumValues) ? (p.minimumValues as unknown[]) : null
+        arrayMaxs = Array.isArray(p.maximumValues) ? (p.maximumValues as unknown[]) : null
+        arrayDefs = Array.isArray(p.defaultValues)
+          ? (p.defaultValues as unknown[])
+          : Array.isArray(p.values)
+            ? (p.values as unknown[])
+            : null
+
+        const next: Array<{ index: number; id: string }> = []
+        for (let i = 0; i < idsRaw.length; i += 1) {
+          const id = normalizeParamId(idsRaw[i])
+          if (id) next.push({ index: i, id })
+        }
+        ids = next
+      }
+    }
+
+    if (ids.length === 0) return empty
+
+    const maxIndex = ids[ids.length - 1].index
+    const table: CompiledParamTable = {
+      indexById: new Map(),
+      min: new Float32Array(maxIndex + 1).fill(Number.NaN),
+      max: new Float32Array(maxIndex + 1).fill(Number.NaN),
+      infos: [],
+    }
+    for (const { index, id } of ids) {
+      const min = arrayMins ? clampNumber(arrayMins[index]) : clampNumber(safeCoreCall(getMinAt, [index], Number.NaN))
+      const max = arrayMaxs ? clampNumber(arrayMaxs[index]) : clampNumber(safeCoreCall(getMaxAt, [index], Number.NaN))
+      const def = arrayDefs ? clampNumber(arrayDefs[index]) : clampNumber(safeCoreCall(getDefAt, [index], Number.NaN))
+      table.indexById.set(id, index)
+      table.min[index] = min ?? Number.NaN
+      table.max[index] = max ?? Number.NaN
+      table.infos.push({ id, min, max, def })
+    }
+    return table
+  }
+
+  // 模型加载早期核心可能还没就绪（参数列表为空），为空时每次重试编译，
+  // 一旦编译成功就缓存整张表
+  let compiled: CompiledParamTable | null = null
+  const ensureTable = (): CompiledParamTable => {
+    if (compiled && compiled.indexById.size > 0) return compiled
+    compiled = buildTable()
+    return compiled
+  }
+
+  // Cubism2 没有按索引列举的公开接口：首次见到某 ID 时用 getParamIndex 解析并缓存
+  // （含未命中的 -1），之后 setParamFloat/getParamFloat 直接走数值索引。
+  const cubism2IndexById = new Map<string, number>()
+  const cubism2IndexOf = (paramId: string): number => {
+    const cached = cubism2IndexById.get(paramId)
+    if (cached !== undefined) return cached
+    const getIndex = core?.getParamIndex
+    const raw = typeof getIndex === 'function' ? safeCoreCall<unknown>(getIndex, [toCubism2ParamName(paramId)], -1) : -1
+    const index = typeof raw === 'number' && Number.isInteger(raw) && raw >= 0 ? raw : -1
+    cubism2IndexById.set(paramId, index)
+    return index
+  }
+
+  const set = (id: string, value: number) => {
+    if (!core) return
+    const paramId = String(id ?? '').trim()
+    if (!paramId) return
+
+    // Cubism4 热路径：命中编译表时按索引写入，clamp 用烘焙好的范围
+    const setByIndex = core.setParameterValueByIndex
+    if (typeof setByIndex === 'function') {
+      const index = ensureTable().indexById.get(paramId)
+      if (index !== undefined) {
+        const table = compiled as CompiledParamTable
+        let v = value
+        if (Number.isFinite(table.min[index]) && v < table.min[index]) v = table.min[index]
+        if (Number.isFinite(table.max[index]) && v > table.max[index]) v = table.max[index]
+        safeCoreCall<void>(setByIndex, [index, v], undefined)
+        return
       }
-      if (out.length > 0) return out
     }
 
-    return []
+    // Cubism4 字符串回退（表编译失败或脚本目标不在表里）
+    const setById = core.setParameterValueById
+    if (typeof setById === 'function') {
+      safeCoreCall<void>(setById, [paramId, value], undefined)
+      return
+    }
+
+    // Cubism2 fallback
+    const setParamFloat = core.setParamFloat
+    if (typeof setParamFloat === 'function') {
+      const index = cubism2IndexOf(paramId)
+      if (index >= 0) safeCoreCall<void>(setParamFloat, [index, value], undefined)
+      else safeCoreCall<void>(setParamFloat, [toCubism2ParamName(paramId), value], undefined)
+    }
   }
 
+  const get = (id: string): number => {
+    if (!core) return Number.NaN
+    const paramId = String(id ?? '').trim()
+    if (!paramId) return Number.NaN
+
+    const getByIndex = core.getParameterValueByIndex
+    if (typeof getByIndex === 'function') {
+      const index = ensureTable().indexById.get(paramId)
+      if (index !== undefined) {
+        const v = safeCoreCall<unknown>(getByIndex, [index], Number.NaN)
+        return typeof v === 'number' && Number.isFinite(v) ? v : Number.NaN
+      }
+    }
+
+    const getById = core.getParameterValueById
+    if (typeof getById === 'function') {
+      const v = safeCoreCall<unknown>(getById, [paramId], Number.NaN)
+      return typeof v === 'number' && Number.isFinite(v) ? v : Number.NaN
+    }
+
+    const getParamFloat = core.getParamFloat
+    if (typeof getParamFloat === 'function') {
+      const index = cubism2IndexOf(paramId)
+      const v = safeCoreCall<unknown>(getParamFloat, [index >= 0 ? index : toCubism2ParamName(paramId)], Number.NaN)
+      return typeof v === 'number' && Number.isFinite(v) ? v : Number.NaN
+    }
+
+    return Number.NaN
+  }
+
+  const listParameters = (): Live2dParameterInfo[] => ensureTable().infos
+
   return { set, get, listParameters }
 }
 
@@ -0,0 +1,30 @@
+// 渲染频率调度：桌宠空闲时把 PIXI ticker 降到低帧率（呼吸/摆动仍在低频推进），
+// 有外部活动（动作/表情/口型同步/鼠标跟踪/拖拽/参数脚本）时立即回到全帧率。
+// 空闲满帧渲染是笔记本续航投诉的主要来源，降到 10fps 后 GPU/CPU 占用约为原来的 1/3。
+
+export const LIVE2D_ACTIVE_FPS = 30
+export const LIVE2D_IDLE_FPS = 10
+
+// 动作/表情是“发射后不管”的（时长在模型侧），触发后保持一段全帧率窗口
+export const LIVE2D_MOTION_BOOST_MS = 4000
+// 鼠标目标更新后的短窗口，确保跟随收敛前不掉帧
+export const LIVE2D_MOUSE_BOOST_MS = 500
+
+export type Live2dRenderActivity = {
+  dragging: boolean
+  mouthOpen: number
+  scriptRunning: boolean
+  /** 鼠标跟随是否已收敛到目标（含回中完成） */
+  mouseSettled: boolean
+  boostUntil: number
+  now: number
+}
+
+export function resolveLive2dMaxFps(activity: Live2dRenderActivity): number {
+  if (activity.dragging) return LIVE2D_ACTIVE_FPS
+  if (activity.scriptRunning) return LIVE2D_ACTIVE_FPS
+  if (activity.mouthOpen > 0.01) return LIVE2D_ACTIVE_FPS
+  if (!activity.mouseSettled) return LIVE2D_ACTIVE_FPS
+  if (activity.now < activity.boostUntil) return LIVE2D_ACTIVE_FPS
+  return LIVE2D_IDLE_FPS
+}
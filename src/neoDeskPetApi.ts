@@ -60,6 +60,7 @@ import type {
   SettingsNavigationTarget,
 } from '../electron/types'
 import type { TtsOptions } from '../electron/ttsOptions'
+import type { TraceSnapshot } from '../electron/tracing'
 
 export type SettingsChangeListener = (settings: AppSettings) => void
 export type Live2DExpressionListener = (expressionName: string) => void
@@ -90,6 +91,11 @@ export type NeoDeskPetApi = {
   clearDebugLog(): Promise<{ ok: true; path: string }>
   appendDebugLog(event: string, data?: unknown): void
 
+  // 追踪面板：IPC/工具/记忆 span 分位数快照与 Chrome trace 导出；渲染进程卡顿上报
+  getTraceSnapshot(): Promise<TraceSnapshot>
+  exportTrace(): Promise<string>
+  reportEventLoopLag(lagMs: number): void
+
   getSettings(): Promise<AppSettings>
   setSecret(target: SettingsSecretTarget, value: string): Promise<{ ok: true; hasValue: boolean }>
   setAlwaysOnTop(value: boolean): Promise<AppSettings>
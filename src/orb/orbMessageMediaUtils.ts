@@ -1,8 +1,10 @@
 import type { NeoDeskPetApi } from '../neoDeskPetApi'
 import {
+  LOCAL_MEDIA_PREVIEW_WIDTH,
   buildLocalMediaReference,
   resolveLocalMediaDataUrl,
   resolveLocalMediaUrl,
+  withLocalMediaWidth,
 } from '../services/localMediaCache'
 import { toLocalMediaSrc } from '../utils/chatMessages'
 
@@ -42,7 +44,11 @@ export async function resolveOrbImageSource(
   const imagePath = String(options.imagePath ?? '').trim()
   if (!api || !imagePath) return ''
 
-  return resolveLocalMediaDataUrl(api, buildLocalMediaReference(imagePath, options.resourceId))
+  const reference = buildLocalMediaReference(imagePath, options.resourceId)
+  // 预览优先拿缩略图 URL；媒体服务不可用时再退回整图 data URL
+  const url = await resolveLocalMediaUrl(api, reference)
+  if (url) return withLocalMediaWidth(url, LOCAL_MEDIA_PREVIEW_WIDTH)
+  return resolveLocalMediaDataUrl(api, reference)
 }
 
 export type OrbVideoSourceOptions = {
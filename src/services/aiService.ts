@@ -1,6 +1,7 @@
 import type { AICredentialRef, AISettings } from '../../electron/types'
 import { buildOpenAICompatReasoningOptions } from '../../electron/reasoningConfig'
 import { getApi } from '../neoDeskPetApi'
+import { SseStreamParser } from './sseStream'
 
 export type ChatContentPart =
   | { type: 'text'; text: string }
@@ -891,7 +892,7 @@ export class AIService {
         }
 
         const reader = response.body.getReader()
-        const decoder = new TextDecoder('utf-8')
+        const parser = new SseStreamParser()
         const onAbort = () => {
           void reader.cancel().catch(() => undefined)
         }
@@ -901,7 +902,6 @@ export class AIService {
         }
         options?.signal?.addEventListener('abort', onAbort, { once: true })
 
-        let buffer = ''
         let streamEnded = false
 
         try {
@@ -917,28 +917,16 @@ export class AIService {
             }
             if (done) break
 
-            buffer += decoder.decode(value, { stream: true })
-
-            // Parse SSE as line stream: each "data: ..." is terminated by \n
-            let hasMoreLines = true
-            while (hasMoreLines) {
+            // 字节级增量解析：已消费的输入不会被重扫（见 sseStream.ts）
+            for (const dataStr of parser.push(value)) {
+              if (streamEnded) break
               if (options?.signal?.aborted) {
                 await reader.cancel().catch(() => undefined)
                 return { content: '', error: ABORTED_ERROR }
               }
-              const lineEnd = buffer.indexOf('\n')
-              if (lineEnd === -1) break
-
-              const line = buffer.slice(0, lineEnd).trim()
-              buffer = buffer.slice(lineEnd + 1)
-              if (!line.startsWith('data:')) continue
-
-              const dataStr = line.slice('data:'.length).trim()
-              if (!dataStr) continue
               if (dataStr === '[DONE]') {
-                buffer = ''
+                parser.reset()
                 streamEnded = true
-                hasMoreLines = false
                 break
               }
 
@@ -976,7 +964,6 @@ export class AIService {
 
                 if (payloadObj.type === 'message_stop') {
                   streamEnded = true
-                  hasMoreLines = false
                 }
                 continue
               }
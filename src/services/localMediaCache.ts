@@ -73,6 +73,18 @@ function writeCache(cache: Map<string, CacheEntry>, key: string, entry: CacheEnt
   }
 }
 
+// 聊天/悬浮球里的图片预览统一请求的缩略图宽度（服务端会向上取整到档位）
+export const LOCAL_MEDIA_PREVIEW_WIDTH = 480
+
+/** 给本地媒体服务的 URL 追加 ?w= 缩略图参数；其他来源（data:/远程）原样返回。 */
+export function withLocalMediaWidth(url: string, width: number): string {
+  const value = String(url ?? '').trim()
+  if (!/^http:\/\/127\.0\.0\.1:\d+\/media\//i.test(value)) return value
+  const w = Math.trunc(width)
+  if (!Number.isFinite(w) || w <= 0) return value
+  return `${value}${value.includes('?') ? '&' : '?'}w=${w}`
+}
+
 export function buildLocalMediaReference(path: string, resourceId?: string): LocalMediaReference {
   const normalizedPath = String(path ?? '').trim()
   const normalizedResourceId = String(resourceId ?? '').trim()
@@ -0,0 +1,96 @@
+// 增量 SSE 字节流解析器（供 aiService 流式路径使用，纯逻辑无 DOM 依赖）
+//
+// 旧实现把每个网络块 decode 进一个字符串 buffer，再反复 indexOf + slice 重建剩余部分，
+// 长回复（大段代码生成）时是 O(n²) 且产生大量临时字符串。这里改为：
+// 1. 字节级复用缓冲区：块直接追加进 Uint8Array，容量不足时倍增，消费过半后整体前移压实；
+// 2. 扫描游标只前进：已扫描过的字节不再重扫，换行查找对整个流是 O(n)；
+// 3. 只对完整行里 "data:" 后的有效负载做一次 UTF-8 解码（'\n' 不会落在多字节序列中间，
+//    按完整行解码是安全的），空行/注释行/其他字段不产生任何字符串。
+
+const NEWLINE = 0x0a
+const DATA_PREFIX = [0x64, 0x61, 0x74, 0x61, 0x3a] // "data:"
+
+function isAsciiWhitespace(byte: number): boolean {
+  return byte === 0x20 || byte === 0x09 || byte === 0x0d
+}
+
+export class SseStreamParser {
+  private buffer = new Uint8Array(16 * 1024)
+  private length = 0
+  private readPos = 0
+  private scanPos = 0
+  private readonly decoder = new TextDecoder('utf-8')
+
+  /**
+   * 追加一个网络块，返回其中所有完整 "data:" 行的有效负载（已去首尾空白，空负载被跳过）。
+   * 不完整的尾部行留在缓冲区，等下一个块续上。
+   */
+  push(chunk: Uint8Array): string[] {
+    this.append(chunk)
+    const payloads: string[] = []
+
+    while (this.scanPos < this.length) {
+      const newlineAt = this.buffer.indexOf(NEWLINE, this.scanPos)
+      if (newlineAt === -1 || newlineAt >= this.length) {
+        this.scanPos = this.length
+        break
+      }
+
+      const payload = this.decodeDataPayload(this.readPos, newlineAt)
+      if (payload) payloads.push(payload)
+      this.readPos = newlineAt + 1
+      this.scanPos = this.readPos
+    }
+
+    this.compact()
+    return payloads
+  }
+
+  /** 丢弃缓冲区中所有未消费内容（流结束或中断时调用）。 */
+  reset(): void {
+    this.length = 0
+    this.readPos = 0
+    this.scanPos = 0
+  }
+
+  private append(chunk: Uint8Array): void {
+    const needed = this.length + chunk.length
+    if (needed > this.buffer.length) {
+      let capacity = this.buffer.length
+      while (capacity < needed) capacity *= 2
+      const grown = new Uint8Array(capacity)
+      grown.set(this.buffer.subarray(0, this.length))
+      this.buffer = grown
+    }
+    this.buffer.set(chunk, this.length)
+    this.length = needed
+  }
+
+  // 已消费部分超过缓冲区一半时整体前移，均摊 O(1)，避免缓冲区随流长度无界增长
+  private compact(): void {
+    if (this.readPos === 0) return
+    if (this.readPos < this.length && this.readPos < this.buffer.length / 2) return
+    this.buffer.copyWithin(0, this.readPos, this.length)
+    this.length -= this.readPos
+    this.scanPos -= this.readPos
+    this.readPos = 0
+  }
+
+  // 对 [start, end) 的一行做字节级匹配："data:" 前缀 + 去空白，命中才解码
+  private decodeDataPayload(start: number, end: number): string {
+    let from = start
+    let to = end
+    while (from < to && isAsciiWhitespace(this.buffer[from])) from++
+    while (to > from && isAsciiWhitespace(this.buffer[to - 1])) to--
+
+    if (to - from <= DATA_PREFIX.length) return ''
+    for (let i = 0; i < DATA_PREFIX.length; i++) {
+      if (this.buffer[from + i] !== DATA_PREFIX[i]) return ''
+    }
+    from += DATA_PREFIX.length
+    while (from < to && isAsciiWhitespace(this.buffer[from])) from++
+    if (from >= to) return ''
+
+    return this.decoder.decode(this.buffer.subarray(from, to))
+  }
+}
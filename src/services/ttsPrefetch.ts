@@ -0,0 +1,78 @@
+// TTS 分句预取流水线：播放第 N 句时让后面至多 K 句的合成请求保持在途，
+// 播放端从队头取“已合成的结果”，消除每句一次合成往返（约数百毫秒）的空档。
+// 结果严格按入队顺序交付，即使后面的句子先合成完也不会乱序。
+// dispose() 一次性丢弃整条流水线：未启动的不再发起，在途的结果到达后被丢弃。
+
+export type TtsPrefetchResult<T> = {
+  text: string
+  audio: T | null
+  error: string | null
+}
+
+export type TtsPrefetchPipeline<T> = {
+  /** 追加待合成的分句（必须与播放队列同序、同数，包括空白段） */
+  push: (text: string) => void
+  /** 取出队头分句并等待其合成完成；没有已入队的分句或已 dispose 时返回 null */
+  shift: () => Promise<TtsPrefetchResult<T> | null>
+  /** 在途 + 已就绪但尚未取走的分句数 */
+  inFlight: () => number
+  dispose: () => void
+}
+
+/** 默认在途深度：够掩盖一次合成往返，又不会在用户打断时浪费太多在途请求 */
+export const TTS_PREFETCH_AHEAD = 2
+
+export function createTtsPrefetchPipeline<T>(options: {
+  synthesize: (text: string) => Promise<T | null>
+  maxAhead?: number
+}): TtsPrefetchPipeline<T> {
+  const maxAhead = Math.max(1, Math.floor(options.maxAhead ?? TTS_PREFETCH_AHEAD))
+  const waiting: string[] = []
+  const started: Array<{ promise: Promise<TtsPrefetchResult<T>> }> = []
+  let disposed = false
+
+  const start = (text: string) => {
+    // 合成失败不让流水线整体拒绝：错误逐句记录，由播放端决定如何上报
+    const promise = options
+      .synthesize(text)
+      .then((audio): TtsPrefetchResult<T> => ({ text, audio, error: null }))
+      .catch(
+        (err): TtsPrefetchResult<T> => ({
+          text,
+          audio: null,
+          error: err instanceof Error ? err.message : String(err),
+        }),
+      )
+    started.push({ promise })
+  }
+
+  const pump = () => {
+    while (!disposed && started.length < maxAhead && waiting.length > 0) {
+      start(waiting.shift() as string)
+    }
+  }
+
+  return {
+    push(text) {
+      if (disposed) return
+      waiting.push(text)
+      pump()
+    },
+    async shift() {
+      if (disposed) return null
+      pump()
+      const item = started.shift()
+      if (!item) return null
+      // 队头出队后立刻补位：当前这句在等待/播放期间，后面的句子保持在途
+      pump()
+      const result = await item.promise
+      return disposed ? null : result
+    },
+    inFlight: () => started.length,
+    dispose() {
+      disposed = true
+      waiting.length = 0
+      started.length = 0
+    },
+  }
+}
@@ -267,6 +267,114 @@ export class TtsPlayer {
     }
   }
 
+  /**
+   * 预取合成：只发请求并解码，不触碰当前播放状态。供分句预取流水线在上一句
+   * 播放期间提前合成下一句，配合 playPrefetched 消除句间的合成往返空档。
+   * 取消 = 调用方直接丢弃返回值；在途请求不中断，代价是至多浪费一段合成。
+   */
+  async prefetch(text: string, settings: TtsSettings): Promise<AudioBuffer | null> {
+    const trimmed = text.trim()
+    if (!trimmed) return null
+    if (!settings.enabled) return null
+
+    const baseUrl = settings.baseUrl.trim().replace(/\/+$/, '')
+    if (!baseUrl) return null
+    if (!settings.refAudioPath.trim()) throw new Error('请先选择参考音频')
+    if (!settings.promptText.trim()) throw new Error('请先填写参考音频文本')
+
+    const ctx = await this.ensureAudioContext()
+    await this.ensureWeights(settings)
+
+    const req = {
+      text: trimmed,
+      text_lang: 'zh',
+      ref_audio_path: settings.refAudioPath.trim(),
+      prompt_lang: 'zh',
+      prompt_text: settings.promptText.trim(),
+      text_split_method: 'cut5',
+      speed_factor: clampNumber(settings.speedFactor, 0.5, 2.0),
+      // 预取总是请求完整 wav：整段一次解码，播放端拿到的就是无缝的 AudioBuffer
+      streaming_mode: false,
+      media_type: 'wav',
+    }
+
+    const api = getApi()
+    let raw: Uint8Array<ArrayBufferLike>
+
+    if (api?.ttsHttpRequestArrayBuffer) {
+      const proxyRes = await api.ttsHttpRequestArrayBuffer({
+        url: `${baseUrl}/tts`,
+        method: 'POST',
+        headers: { 'Content-Type': 'application/json' },
+        body: JSON.stringify(req),
+        timeoutMs: 180000,
+      })
+
+      if (!proxyRes.ok) {
+        let msg = proxyRes.error || `HTTP ${proxyRes.status}`
+        if ((proxyRes.contentType || '').includes('application/json') && proxyRes.arrayBuffer.byteLength > 0) {
+          try {
+            const text = new TextDecoder('utf-8').decode(new Uint8Array(proxyRes.arrayBuffer))
+            const data = JSON.parse(text) as { message?: string }
+            if (data?.message) msg = data.message
+          } catch {
+            // ignore
+          }
+        }
+        throw new Error(formatTtsRequestError(baseUrl, msg))
+      }
+      raw = new Uint8Array(proxyRes.arrayBuffer)
+    } else {
+      const res = await fetch(`${baseUrl}/tts`, {
+        method: 'POST',
+        headers: { 'Content-Type': 'application/json' },
+        body: JSON.stringify(req),
+      })
+      if (!res.ok) {
+        const data = await res.json().catch(() => ({}))
+        throw new Error(formatTtsRequestError(baseUrl, (data as { message?: string })?.message || `HTTP ${res.status}`))
+      }
+      raw = new Uint8Array(await res.arrayBuffer())
+    }
+
+    // 与一次性请求路径相同的 header 重封装兜底
+    if (raw.length >= 44) {
+      const header = raw.slice(0, 44)
+      if (isWavHeader(header)) {
+        try {
+          return await ctx.decodeAudioData(toArrayBuffer(createWavFromChunk(header, raw.slice(44))))
+        } catch {
+          // 解码失败则回落到整包解码
+        }
+      }
+    }
+    return await ctx.decodeAudioData(toArrayBuffer(raw))
+  }
+
+  /**
+   * 播放一段预取好的已解码音频。回调语义与 speak 一致（先 stop 当前播放），
+   * 但没有任何网络往返，调用后立即入队播放。
+   */
+  async playPrefetched(
+    audioBuffer: AudioBuffer,
+    callbacks?: {
+      onFirstPlay?: () => void
+      onChunkStart?: (payload: { offsetSec: number; durationSec: number }) => void
+      onEnded?: () => void
+    },
+  ): Promise<void> {
+    this.stop()
+    this.streamDone = false
+    this.firstPlayFired = false
+    this.onFirstPlay = callbacks?.onFirstPlay ?? null
+    this.onChunkStart = callbacks?.onChunkStart ?? null
+    this.onEnded = callbacks?.onEnded ?? null
+
+    await this.ensureAudioContext()
+    this.playDecodedBuffer(audioBuffer)
+    this.streamDone = true
+  }
+
   getLevel(): number {
     const analyser = this.analyser
     const ctx = this.audioContext
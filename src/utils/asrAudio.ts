@@ -22,41 +22,56 @@ export function concatFloat32(a: Float32Array, b: Float32Array): Float32Array {
   return out
 }
 
-export function createOpenTypelessPcmSender(ws: WebSocket, inputSampleRate: number): (pcm: Float32Array) => void {
-  const targetSampleRate = 16000
+/**
+ * 降采样 + PCM16 编码器（OpenTypeless demo ws 默认按 16kHz / int16 PCM 读取）。
+ * 必须保持完全自包含（不引用模块作用域里的任何符号）：buildAsrCaptureWorkletCode
+ * 会用 Function.prototype.toString() 把它注入 AudioWorklet 源码，在音频线程里执行，
+ * 让每个分块的重采样/编码不占用 UI 线程。输入不足一个输出采样时返回 null（余量下次续上）。
+ */
+export function createAsrPcm16Encoder(
+  inputSampleRate: number,
+  targetSampleRate: number,
+): (pcm: Float32Array) => Int16Array | null {
   let carry = new Float32Array(0)
 
-  const sendInt16 = (source: Float32Array) => {
-    if (!source.length) return
+  const toInt16 = (v: number): number => {
+    const s = Math.max(-1, Math.min(1, Number.isFinite(v) ? v : 0))
+    return s < 0 ? Math.round(s * 0x8000) : Math.round(s * 0x7fff)
+  }
+
+  const straightInt16 = (source: Float32Array): Int16Array | null => {
+    if (!source.length) return null
     const out = new Int16Array(source.length)
-    for (let i = 0; i < source.length; i++) out[i] = floatToPcm16(source[i])
-    ws.send(out.buffer)
+    for (let i = 0; i < source.length; i++) out[i] = toInt16(source[i])
+    return out
   }
 
   return (pcm: Float32Array) => {
-    if (ws.readyState !== WebSocket.OPEN) return
-    if (!(pcm instanceof Float32Array) || pcm.length <= 0) return
+    if (!(pcm instanceof Float32Array) || pcm.length <= 0) return null
 
-    const merged = carry.length ? concatFloat32(carry, pcm) : pcm
+    let merged = pcm
+    if (carry.length) {
+      merged = new Float32Array(carry.length + pcm.length)
+      merged.set(carry, 0)
+      merged.set(pcm, carry.length)
+    }
 
-    // OpenTypeless demo ws 默认按 16kHz / int16 PCM 读取；优先用 16k AudioContext，必要时在前端降采样兜底。
+    // 采样率未知 / 已是目标采样率 / 低于目标采样率时不做重采样，直接转 int16
     if (!Number.isFinite(inputSampleRate) || inputSampleRate <= 0 || Math.abs(inputSampleRate - targetSampleRate) < 1) {
       carry = new Float32Array(0)
-      sendInt16(merged)
-      return
+      return straightInt16(merged)
     }
 
     if (inputSampleRate < targetSampleRate) {
       carry = new Float32Array(0)
-      sendInt16(merged)
-      return
+      return straightInt16(merged)
     }
 
     const ratio = inputSampleRate / targetSampleRate
     const outLen = Math.floor(merged.length / ratio)
     if (outLen <= 0) {
       carry = merged.slice()
-      return
+      return null
     }
 
     const out = new Int16Array(outLen)
@@ -70,11 +85,70 @@ export function createOpenTypelessPcmSender(ws: WebSocket, inputSampleRate: numb
         sourceIndex += 1
         count += 1
       }
-      out[i] = floatToPcm16(count > 0 ? sum / count : 0)
+      out[i] = toInt16(count > 0 ? sum / count : 0)
     }
     carry = sourceIndex < merged.length ? merged.slice(sourceIndex) : new Float32Array(0)
-    ws.send(out.buffer)
+    return out
+  }
+}
+
+export function createOpenTypelessPcmSender(ws: WebSocket, inputSampleRate: number): (pcm: Float32Array) => void {
+  const encode = createAsrPcm16Encoder(inputSampleRate, 16000)
+
+  return (pcm: Float32Array) => {
+    if (ws.readyState !== WebSocket.OPEN) return
+    const out = encode(pcm)
+    if (out && out.length) ws.send(out.buffer)
+  }
+}
+
+/**
+ * 生成 ASR 采集用的 AudioWorklet 处理器源码。encodePcm16=true 时把降采样 + PCM16
+ * 编码整个搬进音频线程（worklet 全局有 sampleRate 可用），port 消息直接是可发送的
+ * Int16Array；否则保持原始 Float32 分块，由 UI 线程按后端协议处理。
+ */
+export function buildAsrCaptureWorkletCode(opts: { bufferSize: number; encodePcm16: boolean }): string {
+  const bufferSize = Math.max(128, Math.floor(opts.bufferSize))
+  const encoderSetup = opts.encodePcm16
+    ? `const encode = (${createAsrPcm16Encoder.toString()})(sampleRate, 16000);`
+    : 'const encode = null;'
+
+  return `
+${encoderSetup}
+class NdpPcmProcessor extends AudioWorkletProcessor {
+  constructor() {
+    super();
+    this._buf = new Float32Array(${bufferSize});
+    this._idx = 0;
   }
+  _flush() {
+    if (encode) {
+      const out = encode(this._buf);
+      if (out && out.length) this.port.postMessage(out, [out.buffer]);
+    } else {
+      this.port.postMessage(this._buf, [this._buf.buffer]);
+    }
+    this._buf = new Float32Array(${bufferSize});
+    this._idx = 0;
+  }
+  process(inputs) {
+    const input = inputs[0];
+    if (input && input[0]) {
+      const ch = input[0];
+      let off = 0;
+      while (off < ch.length) {
+        const take = Math.min(ch.length - off, this._buf.length - this._idx);
+        this._buf.set(ch.subarray(off, off + take), this._idx);
+        this._idx += take;
+        off += take;
+        if (this._idx >= this._buf.length) this._flush();
+      }
+    }
+    return true;
+  }
+}
+registerProcessor('ndp-pcm', NdpPcmProcessor);
+`
 }
 
 export function escapeRegExp(input: string): string {
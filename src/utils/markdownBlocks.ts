@@ -0,0 +1,77 @@
+// 流式 Markdown 的增量切块：把累积文本按顶层块边界切开，已闭合的块内容在后续追加时保持不变，
+// 渲染侧据此把解析成本限制在“最后一个未闭合块”上（见 MarkdownMessage 的分块 memo）。
+// 边界判定偏保守：围栏代码内不切；列表/缩进/表格跨空行不切，避免松散列表被拆成两个列表。
+
+const FENCE_RE = /^(\s{0,3})(```+|~~~+)/
+const LIST_ITEM_RE = /^\s{0,3}(?:[-*+]|\d{1,9}[.)])(?:\s|$)/
+const INDENTED_RE = /^(?:\s{4,}|\t)/
+const TABLE_ROW_RE = /^\s{0,3}\|/
+
+/**
+ * 把 Markdown 文本切成顶层块。保证：对任意 text 与追加 delta，
+ * split(text + delta) 的前 n-1 个块与 split(text) 的前缀一致（最后一个块视为未闭合）。
+ */
+export function splitMarkdownBlocks(text: string): string[] {
+  const source = String(text ?? '')
+  if (!source) return []
+
+  const lines = source.split('\n')
+  const blocks: string[] = []
+  let current: string[] = []
+  let fenceMarker: string | null = null
+
+  const flush = () => {
+    while (current.length > 0 && current[current.length - 1].trim() === '') current.pop()
+    if (current.length > 0) blocks.push(current.join('\n'))
+    current = []
+  }
+
+  for (let i = 0; i < lines.length; i++) {
+    const line = lines[i]
+
+    if (fenceMarker) {
+      current.push(line)
+      const closing = line.match(FENCE_RE)
+      if (closing && closing[2][0] === fenceMarker[0] && closing[2].length >= fenceMarker.length) {
+        fenceMarker = null
+      }
+      continue
+    }
+
+    const opening = line.match(FENCE_RE)
+    if (opening) {
+      // 新起的围栏另开一块，避免前面的段落跟着代码块一起重渲染
+      if (line.trim().startsWith(opening[2]) && current.some((prev) => prev.trim() !== '')) flush()
+      fenceMarker = opening[2]
+      current.push(line)
+      continue
+    }
+
+    if (line.trim() === '') {
+      const next = lines[i + 1]
+      if (next === undefined) {
+        current.push(line)
+        continue
+      }
+      const prevLine = [...current].reverse().find((candidate) => candidate.trim() !== '') ?? ''
+      const keepTogether =
+        LIST_ITEM_RE.test(next) ||
+        INDENTED_RE.test(next) ||
+        TABLE_ROW_RE.test(next) ||
+        LIST_ITEM_RE.test(prevLine) ||
+        INDENTED_RE.test(prevLine) ||
+        TABLE_ROW_RE.test(prevLine)
+      if (keepTogether) {
+        current.push(line)
+      } else {
+        flush()
+      }
+      continue
+    }
+
+    current.push(line)
+  }
+
+  flush()
+  return blocks
+}
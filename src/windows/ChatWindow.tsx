@@ -5,7 +5,7 @@ import type { AppSettings, ChatAttachment, ChatMessageBlock, ChatMessageRecord,
 import { ContextUsageOrb } from '../components/ContextUsageOrb'
 import { getLiveRegionProps } from '../components/liveRegion'
 import { useDialogFocus } from '../hooks/useDialogFocus'
-import { useProgressiveMessageWindow } from '../hooks/useProgressiveMessageWindow'
+import { useVirtualizedMessageList } from '../hooks/useVirtualizedMessageList'
 import { resolveLocalMediaDataUrl, resolveLocalMediaUrl } from '../services/localMediaCache'
 import { ImageViewer, type ImageViewerItem } from './chat/ImageViewer'
 import { ChatComposer, type PendingChatAttachment } from './chat/ChatComposer'
@@ -821,22 +821,15 @@ export function ChatWindow(props: { api: ReturnType<typeof getApi> }) {
   const userAvatar = chatProfile?.userAvatar
   const assistantAvatar = chatProfile?.assistantAvatar
   const ttsSegmentedUi = (settings?.tts?.enabled ?? false) && (settings?.tts?.segmented ?? false)
+  // 真虚拟化：只渲染视口附近的消息行，其余由上下占位块撑出滚动高度（长会话内存/节点数 O(视口)）
+  const getMessageId = useCallback((m: ChatMessageRecord) => m.id, [])
   const {
     visibleItems: visibleMessages,
-    hiddenCount: hiddenMessageCount,
-    loadEarlier: loadEarlierMessageWindow,
-  } = useProgressiveMessageWindow(messages, currentSessionId ?? '')
-  const loadEarlierMessages = useCallback(() => {
-    const list = messagesListRef.current
-    const previousScrollHeight = list?.scrollHeight ?? 0
-    loadEarlierMessageWindow()
-    if (!list) return
-    window.requestAnimationFrame(() => {
-      const current = messagesListRef.current
-      if (!current) return
-      current.scrollTop += Math.max(0, current.scrollHeight - previousScrollHeight)
-    })
-  }, [loadEarlierMessageWindow])
+    topPad: messagesTopPad,
+    bottomPad: messagesBottomPad,
+  } = useVirtualizedMessageList(messages, getMessageId, messagesListRef, currentSessionId ?? '', {
+    rowGapPx: 6, // 与 .ndp-chat-messages 的 flex gap 保持一致，占位高度才不累计偏差
+  })
 
   useEffect(() => {
     plannerPendingRef.current = false
@@ -3633,31 +3626,33 @@ export function ChatWindow(props: { api: ReturnType<typeof getApi> }) {
             </div>
           </div>
         ) : null}
-        {hiddenMessageCount > 0 ? (
-          <button type="button" className="ndp-message-history-more" onClick={loadEarlierMessages}>
-            加载更早消息（还有 {hiddenMessageCount} 条）
-          </button>
+        {messagesTopPad > 0 ? (
+          <div className="ndp-chat-virtual-pad" style={{ height: messagesTopPad }} aria-hidden="true" />
         ) : null}
         {visibleMessages.map((m) => (
-          <ChatMessageItem
-            key={m.id}
-            m={m}
-            api={api}
-            avatar={m.role === 'user' ? userAvatar : assistantAvatar}
-            segmentedActive={m.role !== 'user' && ttsSegmentedUi && !!ttsSegmentedMessageFlags[m.id]}
-            revealCount={ttsRevealedSegments[m.id]}
-            tasksById={tasksById}
-            isEditing={editingMessageId === m.id}
-            editingContent={editingMessageId === m.id ? editingMessageContent : ''}
-            editingTextareaRef={editingTextareaRef}
-            onEditingContentChange={setEditingMessageContent}
-            onSaveEdit={handleSaveEdit}
-            onCancelEdit={handleCancelEdit}
-            onContextMenu={handleMessageContextMenu}
-            onPickAvatar={pickAvatar}
-            onRerollImageGenerate={handleRerollImageGenerate}
-          />
+          <div key={m.id} data-virtual-row-id={m.id}>
+            <ChatMessageItem
+              m={m}
+              api={api}
+              avatar={m.role === 'user' ? userAvatar : assistantAvatar}
+              segmentedActive={m.role !== 'user' && ttsSegmentedUi && !!ttsSegmentedMessageFlags[m.id]}
+              revealCount={ttsRevealedSegments[m.id]}
+              tasksById={tasksById}
+              isEditing={editingMessageId === m.id}
+              editingContent={editingMessageId === m.id ? editingMessageContent : ''}
+              editingTextareaRef={editingTextareaRef}
+              onEditingContentChange={setEditingMessageContent}
+              onSaveEdit={handleSaveEdit}
+              onCancelEdit={handleCancelEdit}
+              onContextMenu={handleMessageContextMenu}
+              onPickAvatar={pickAvatar}
+              onRerollImageGenerate={handleRerollImageGenerate}
+            />
+          </div>
         ))}
+        {messagesBottomPad > 0 ? (
+          <div className="ndp-chat-virtual-pad" style={{ height: messagesBottomPad }} aria-hidden="true" />
+        ) : null}
         {(settings?.tts?.enabled ?? false) && (settings?.tts?.segmented ?? false) && ttsPendingUtteranceId ? (
           <div className="ndp-msg-row ndp-msg-row-pet" title="生成中…">
             <button
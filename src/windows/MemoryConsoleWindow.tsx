@@ -12,6 +12,7 @@ import type {
   Persona,
   PersonaSummary,
 } from '../../electron/types'
+import type { TraceSnapshot } from '../../electron/tracing'
 import { getLiveRegionProps } from '../components/liveRegion'
 import { useVisibleInterval } from '../hooks/useVisibleInterval'
 import { getApi } from '../neoDeskPetApi'
@@ -142,6 +143,9 @@ export function MemoryConsoleWindow(props: Props) {
   const [extractWriteToSelectedPersona, setExtractWriteToSelectedPersona] = useState(false)
   const [extractSaveScope, setExtractSaveScope] = useState<'model' | 'persona' | 'shared'>('model')
 
+  const [traceSnapshot, setTraceSnapshot] = useState<TraceSnapshot | null>(null)
+  const [traceError, setTraceError] = useState<string | null>(null)
+
   useEffect(() => {
     if (!settings?.ai) return
     getAIService(settings.ai)
@@ -414,12 +418,44 @@ export function MemoryConsoleWindow(props: Props) {
     fetchList,
   ])
 
+  const fetchTraceSnapshot = useCallback(async () => {
+    if (!api?.getTraceSnapshot) return
+    try {
+      setTraceSnapshot(await api.getTraceSnapshot())
+      setTraceError(null)
+    } catch (err) {
+      console.error(err)
+      setTraceError(err instanceof Error ? err.message : String(err))
+    }
+  }, [api])
+
+  const downloadTrace = useCallback(async () => {
+    if (!api?.exportTrace) return
+    try {
+      const json = await api.exportTrace()
+      const url = URL.createObjectURL(new Blob([json], { type: 'application/json' }))
+      const anchor = document.createElement('a')
+      anchor.href = url
+      anchor.download = `neodeskpet-trace-${Date.now()}.json`
+      anchor.click()
+      URL.revokeObjectURL(url)
+    } catch (err) {
+      console.error(err)
+      setTraceError(err instanceof Error ? err.message : String(err))
+    }
+  }, [api])
+
   useEffect(() => {
     void fetchConflicts()
   }, [fetchConflicts])
 
+  useEffect(() => {
+    void fetchTraceSnapshot()
+  }, [fetchTraceSnapshot])
+
   useVisibleInterval(() => void fetchList(offset), 1500, autoRefresh)
   useVisibleInterval(() => void fetchConflicts(), 2000, autoRefresh)
+  useVisibleInterval(() => void fetchTraceSnapshot(), 3000, autoRefresh)
 
   const activeMemory = useMemo(() => {
     if (!activeRowid) return null
@@ -1606,6 +1642,60 @@ export function MemoryConsoleWindow(props: Props) {
             </div>
           )}
         </div>
+
+        <div className="ndp-settings-section">
+          <h3>性能诊断（IPC / 工具 / 记忆耗时与事件循环卡顿）</h3>
+          <div className="ndp-row" style={{ marginBottom: 10 }}>
+            <button className="ndp-btn" onClick={() => void fetchTraceSnapshot()}>
+              刷新
+            </button>
+            <button className="ndp-btn" onClick={() => void downloadTrace()}>
+              导出 trace（chrome://tracing 可打开）
+            </button>
+            {traceError ? (
+              <span style={{ marginLeft: 10, fontSize: 12, color: 'rgba(255,180,180,0.95)' }} {...getLiveRegionProps('assertive')}>
+                {traceError}
+              </span>
+            ) : null}
+          </div>
+          {!traceSnapshot ? (
+            <div style={{ color: 'rgba(255,255,255,0.6)' }}>暂无追踪数据</div>
+          ) : (
+            <div>
+              <div style={{ fontSize: 12, color: 'rgba(255,255,255,0.72)', marginBottom: 6 }}>
+                事件循环卡顿（p50 / p99 / 峰值，ms）
+              </div>
+              <div style={{ display: 'flex', flexWrap: 'wrap', gap: 10, fontSize: 12, color: 'rgba(255,255,255,0.55)', marginBottom: 12 }}>
+                {traceSnapshot.eventLoop.length === 0 ? (
+                  <span>暂无采样</span>
+                ) : (
+                  traceSnapshot.eventLoop.map((lag) => (
+                    <span key={lag.target}>
+                      {lag.target}: {lag.p50Ms.toFixed(1)} / {lag.p99Ms.toFixed(1)} / {lag.maxMs.toFixed(1)}
+                    </span>
+                  ))
+                )}
+              </div>
+              <div style={{ fontSize: 12, color: 'rgba(255,255,255,0.72)', marginBottom: 6 }}>
+                耗时 span（按 p99 降序，最多 20 条）
+              </div>
+              <div className="ndp-memory-list">
+                {traceSnapshot.spans.slice(0, 20).map((span) => (
+                  <div key={`${span.category}:${span.name}`} className="ndp-memory-item">
+                    <div className="ndp-memory-meta" style={{ flexWrap: 'wrap' }}>
+                      <span>{span.category}</span>
+                      <span>{span.name}</span>
+                      <span style={{ marginLeft: 'auto' }}>
+                        p50:{span.p50Ms.toFixed(1)}ms p99:{span.p99Ms.toFixed(1)}ms max:{span.maxMs.toFixed(1)}ms ×{span.count}
+                      </span>
+                    </div>
+                  </div>
+                ))}
+                {traceSnapshot.spans.length === 0 && <div style={{ color: 'rgba(255,255,255,0.6)' }}>暂无 span 记录</div>}
+              </div>
+            </div>
+          )}
+        </div>
       </div>
     </div>
   )
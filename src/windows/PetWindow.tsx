@@ -6,8 +6,14 @@ import { SpeechBubble } from '../components/SpeechBubble'
 import { Live2DView } from '../live2d/Live2DView'
 import { parseModelMetadata } from '../live2d/live2dModels'
 import { getApi } from '../neoDeskPetApi'
+import { createTtsPrefetchPipeline, type TtsPrefetchPipeline } from '../services/ttsPrefetch'
 import { TtsPlayer } from '../services/ttsService'
-import { applyAsrLocalRules, createOpenTypelessPcmSender, waitForOpenTypelessAsrReady } from '../utils/asrAudio'
+import {
+  applyAsrLocalRules,
+  buildAsrCaptureWorkletCode,
+  createOpenTypelessPcmSender,
+  waitForOpenTypelessAsrReady,
+} from '../utils/asrAudio'
 import { BUBBLE_PREVIEW_FALLBACK_PREFIX, filterVisibleToolRuns } from '../utils/chatMessages'
 import { isOpenTypelessAsrWsUrl } from '../utils/settingsHelpers'
 import { resolveTtsPlaybackText, trimTrailingCommaForSegment } from '../utils/ttsText'
@@ -31,9 +37,13 @@ export function PetWindow() {
   const ttsPlayerRef = useRef<TtsPlayer | null>(null)
   const bubbleTtsQueueRef = useRef<string[]>([])
   const bubbleTtsRunningRef = useRef(false)
-  const ttsQueueRef = useRef<
-    { utteranceId: string; segments: string[]; finalized: boolean; playIndex: number } | null
-  >(null)
+  const ttsQueueRef = useRef<{
+    utteranceId: string
+    segments: string[]
+    finalized: boolean
+    playIndex: number
+    pipeline: TtsPrefetchPipeline<AudioBuffer>
+  } | null>(null)
   const ttsQueueWakeRef = useRef<(() => void) | null>(null)
   const ttsQueueRunningRef = useRef(false)
   const ttsActiveUtteranceRef = useRef<string | null>(null)
@@ -403,35 +413,8 @@ export function PetWindow() {
         if (backend === 'script') return null
         if (!audioContext.audioWorklet) return null
 
-        const workletCode = `
-class NdpPcmProcessor extends AudioWorkletProcessor {
-  constructor() {
-    super();
-    this._buf = new Float32Array(${bufferSize});
-    this._idx = 0;
-  }
-  process(inputs) {
-    const input = inputs[0];
-    if (input && input[0]) {
-      const ch = input[0];
-      let off = 0;
-      while (off < ch.length) {
-        const take = Math.min(ch.length - off, this._buf.length - this._idx);
-        this._buf.set(ch.subarray(off, off + take), this._idx);
-        this._idx += take;
-        off += take;
-        if (this._idx >= this._buf.length) {
-          this.port.postMessage(this._buf, [this._buf.buffer]);
-          this._buf = new Float32Array(${bufferSize});
-          this._idx = 0;
-        }
-      }
-    }
-    return true;
-  }
-}
-registerProcessor('ndp-pcm', NdpPcmProcessor);
-`
+        // OpenTypeless 协议下降采样 + PCM16 编码直接在音频线程完成，UI 线程只转发
+        const workletCode = buildAsrCaptureWorkletCode({ bufferSize, encodePcm16: useOpenTypelessWs })
         const blobUrl = URL.createObjectURL(new Blob([workletCode], { type: 'text/javascript' }))
         try {
           await audioContext.audioWorklet.addModule(blobUrl)
@@ -447,6 +430,11 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
 
         workletNode.port.onmessage = (ev) => {
           const buf = ev.data
+          if (buf instanceof Int16Array) {
+            // 音频线程已编码完毕，这里零拷贝直发
+            if (ws.readyState === WebSocket.OPEN) ws.send(buf.buffer)
+            return
+          }
           if (buf instanceof Float32Array) {
             sendPcm(buf)
             return
@@ -1085,6 +1073,7 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
             if (current.finalized) {
               const utteranceId = current.utteranceId
               if (ttsActiveUtteranceRef.current === utteranceId) ttsActiveUtteranceRef.current = null
+              current.pipeline.dispose()
               ttsQueueRef.current = null
               setMouthOpen(0)
               setBubblePayload(null)
@@ -1104,19 +1093,23 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
           current.playIndex = segmentIndex + 1
           const raw = String(current.segments[segmentIndex] ?? '')
           const segText = raw.trim()
-          if (!segText) continue
 
           if (!ttsPlayerRef.current) ttsPlayerRef.current = new TtsPlayer()
           const player = ttsPlayerRef.current
           if (!player) continue
 
+          // 预取流水线与 segments 严格同序：即使是空白段也要取走队头保持对齐。
+          // 上一句播放期间这一句通常已经合成完毕，这里基本不等待。
+          const prefetched = await current.pipeline.shift()
+          if (ttsQueueRef.current !== current) continue
+          if (!prefetched || !segText) continue
+
           ttsActiveUtteranceRef.current = utteranceId
 
           const showBubble = s.bubble?.showOnChat ?? false
           const bubbleDelay = s.bubble?.autoHideDelay ?? 5000
-          const ttsSettings = { ...s.tts, streaming: true, segmented: false }
           const pauseMs = Math.max(0, Math.min(60000, Math.floor(s.tts.pauseMs ?? 0)))
-          const speechText = resolveTtsPlaybackText(segText, s.tts)
+          const audio = prefetched.audio
 
           if (showBubble) setBubblePayload({ text: segText, startAt: null, mode: 'append', autoHideDelay: bubbleDelay })
 
@@ -1137,7 +1130,16 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
             }
           }
 
-          if (!speechText) {
+          if (prefetched.error) {
+            try {
+              api.reportTtsUtteranceFailed({ utteranceId, error: prefetched.error })
+            } catch {
+              /* ignore */
+            }
+            continue
+          }
+
+          if (!audio) {
             reportVoiceStart()
             setMouthOpen(0)
             if (pauseMs > 0) await sleep(Math.min(pauseMs, 200))
@@ -1146,7 +1148,7 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
 
           await new Promise<void>((resolve) => {
             void player
-              .speak(speechText, ttsSettings, {
+              .playPrefetched(audio, {
                 onFirstPlay: () => {
                   const startedAt = Date.now()
                   const threshold = 0.006
@@ -1201,6 +1203,7 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
         if (prev && prev.utteranceId !== payload.utteranceId) {
           api.reportTtsUtteranceEnded({ utteranceId: prev.utteranceId })
         }
+        prev?.pipeline.dispose()
         ttsActiveUtteranceRef.current = null
         ttsPlayerRef.current?.stop()
         setMouthOpen(0)
@@ -1209,6 +1212,17 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
           segments: [],
           finalized: false,
           playIndex: 0,
+          // 播放第 N 句时让后面的句子保持在途合成，消除句间的合成往返空档
+          pipeline: createTtsPrefetchPipeline<AudioBuffer>({
+            synthesize: async (segText) => {
+              const cur = settingsRef.current
+              const player = ttsPlayerRef.current
+              if (!cur?.tts?.enabled || !player) return null
+              const speechText = resolveTtsPlaybackText(segText.trim(), cur.tts)
+              if (!speechText) return null
+              return player.prefetch(speechText, { ...cur.tts, streaming: false, segmented: false })
+            },
+          }),
         }
         setBubblePayload(null)
         wakeQueue()
@@ -1217,7 +1231,10 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
       const current = ttsQueueRef.current
       if (!current || current.utteranceId !== payload.utteranceId) return
 
-      if (payload.segments?.length) current.segments.push(...payload.segments)
+      if (payload.segments?.length) {
+        current.segments.push(...payload.segments)
+        for (const seg of payload.segments) current.pipeline.push(String(seg ?? ''))
+      }
       wakeQueue()
       void runQueue()
     })
@@ -1246,6 +1263,7 @@ registerProcessor('ndp-pcm', NdpPcmProcessor);
 
       bubbleTtsQueueRef.current = []
       ttsActiveUtteranceRef.current = null
+      ttsQueueRef.current?.pipeline.dispose()
       ttsQueueRef.current = null
       ttsQueueRunningRef.current = false
       ttsPlayerRef.current?.stop()
@@ -65,16 +65,43 @@ describe('AI HTTP proxy', () => {
       settings.ai.baseUrl = `${origin}/v1`
       const proxy = new AIHttpProxy(() => settings)
 
-      const result = await proxy.request({
-        credential: { kind: 'main' },
-        body: { model: 'test-model', messages: [] },
-      })
-      expect(result.ok).toBe(true)
-      expect(JSON.parse(result.bodyText)).toEqual({
-        path: '/v1/chat/completions',
-        authorization: 'Bearer main-process-secret',
-        body: { model: 'test-model', messages: [] },
-      })
+      try {
+        const result = await proxy.request({
+          credential: { kind: 'main' },
+          body: { model: 'test-model', messages: [] },
+        })
+        expect(result.ok).toBe(true)
+        expect(JSON.parse(result.bodyText)).toEqual({
+          path: '/v1/chat/completions',
+          authorization: 'Bearer main-process-secret',
+          body: { model: 'test-model', messages: [] },
+        })
+      } finally {
+        proxy.close()
+      }
+    })
+  })
+
+  it('reuses pooled keep-alive sockets across sequential requests and reports metrics', async () => {
+    await withServer((_request, response) => {
+      response.setHeader('Content-Type', 'application/json')
+      response.end('{}')
+    }, async (origin) => {
+      const settings = createDefaultSettings()
+      settings.ai.apiKey = 'pool-secret'
+      settings.ai.baseUrl = `${origin}/v1`
+      const proxy = new AIHttpProxy(() => settings)
+
+      try {
+        await proxy.request({ credential: { kind: 'main' }, body: { model: 'test-model', messages: [] } })
+        await proxy.request({ credential: { kind: 'main' }, body: { model: 'test-model', messages: [] } })
+
+        const metrics = proxy.getPoolMetrics()
+        expect(metrics.totals).toEqual({ requests: 2, reusedSockets: 1, handshakes: 1 })
+        expect(metrics.origins[origin]).toEqual({ requests: 2, reusedSockets: 1, handshakes: 1 })
+      } finally {
+        proxy.close()
+      }
     })
   })
 
@@ -107,17 +134,21 @@ describe('AI HTTP proxy', () => {
       ]
       const proxy = new AIHttpProxy(() => settings)
 
-      const result = await proxy.request({
-        credential: { kind: 'profile', profileId: 'vision-claude' },
-        body: { model: 'claude-test', messages: [] },
-      })
-      expect(result.ok).toBe(true)
-      expect(JSON.parse(result.bodyText)).toEqual({
-        path: '/v1/messages',
-        apiKey: 'profile-process-secret',
-        anthropicVersion: '2023-06-01',
-        body: { model: 'claude-test', messages: [] },
-      })
+      try {
+        const result = await proxy.request({
+          credential: { kind: 'profile', profileId: 'vision-claude' },
+          body: { model: 'claude-test', messages: [] },
+        })
+        expect(result.ok).toBe(true)
+        expect(JSON.parse(result.bodyText)).toEqual({
+          path: '/v1/messages',
+          apiKey: 'profile-process-secret',
+          anthropicVersion: '2023-06-01',
+          body: { model: 'claude-test', messages: [] },
+        })
+      } finally {
+        proxy.close()
+      }
     })
   })
 
@@ -160,6 +191,7 @@ describe('AI HTTP proxy', () => {
       expect(chunks).toContain('hello')
       expect(events.at(-1)?.channel).toBe('ai:httpStreamDone')
       expect(proxy.cancelStream(7, 'stream_test_1234')).toEqual({ ok: true })
+      proxy.close()
     })
   })
 })
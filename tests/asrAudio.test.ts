@@ -0,0 +1,71 @@
+import { describe, expect, it, vi } from 'vitest'
+import { buildAsrCaptureWorkletCode, createAsrPcm16Encoder, createOpenTypelessPcmSender } from '../src/utils/asrAudio'
+
+describe('createAsrPcm16Encoder', () => {
+  it('converts straight to int16 when input is already at the target rate', () => {
+    const encode = createAsrPcm16Encoder(16000, 16000)
+    const out = encode(new Float32Array([0, 0.5, -0.5, 1, -1]))
+    expect(out).not.toBeNull()
+    expect(Array.from(out as Int16Array)).toEqual([0, Math.round(0.5 * 0x7fff), -Math.round(0.5 * 0x8000), 0x7fff, -0x8000])
+  })
+
+  it('downsamples by averaging and carries the remainder to the next chunk', () => {
+    const encode = createAsrPcm16Encoder(32000, 16000)
+    const out = encode(new Float32Array([0.1, 0.3, 0.5, 0.7, 0.2]))
+    expect(Array.from(out as Int16Array)).toEqual([
+      Math.round(((0.1 + 0.3) / 2) * 0x7fff),
+      Math.round(((0.5 + 0.7) / 2) * 0x7fff),
+    ])
+
+    // 上一块剩下的 0.2 与下一块的首样本平均
+    const next = encode(new Float32Array([0.4]))
+    expect(Array.from(next as Int16Array)).toEqual([Math.round(((0.2 + 0.4) / 2) * 0x7fff)])
+  })
+
+  it('returns null until enough samples accumulate for one output sample', () => {
+    const encode = createAsrPcm16Encoder(48000, 16000)
+    expect(encode(new Float32Array([0.1]))).toBeNull()
+    expect(encode(new Float32Array([0.1]))).toBeNull()
+    const out = encode(new Float32Array([0.1]))
+    expect(out).not.toBeNull()
+    expect((out as Int16Array).length).toBe(1)
+  })
+
+  it('is fully self-contained so it can run inside an AudioWorklet scope', () => {
+    // buildAsrCaptureWorkletCode 用 toString() 注入音频线程；这里验证序列化后仍可独立求值
+    const factory = new Function(`return (${createAsrPcm16Encoder.toString()})`)() as typeof createAsrPcm16Encoder
+    const encode = factory(32000, 16000)
+    const out = encode(new Float32Array([0.5, 0.5]))
+    expect(Array.from(out as Int16Array)).toEqual([Math.round(0.5 * 0x7fff)])
+  })
+})
+
+describe('createOpenTypelessPcmSender', () => {
+  it('sends encoded int16 buffers only while the socket is open', () => {
+    // node 测试环境没有 WebSocket 全局；sender 内部会读 WebSocket.OPEN，这里补一个最小常量对象
+    vi.stubGlobal('WebSocket', { OPEN: 1 })
+    const sent: ArrayBuffer[] = []
+    const fake = { readyState: 1, send: (buf: ArrayBuffer) => sent.push(buf) }
+    const send = createOpenTypelessPcmSender(fake as unknown as WebSocket, 16000)
+
+    send(new Float32Array([0.25, -0.25]))
+    expect(sent).toHaveLength(1)
+    expect(Array.from(new Int16Array(sent[0]))).toEqual([Math.round(0.25 * 0x7fff), -Math.round(0.25 * 0x8000)])
+
+    fake.readyState = 3
+    send(new Float32Array([0.25]))
+    expect(sent).toHaveLength(1)
+  })
+})
+
+describe('buildAsrCaptureWorkletCode', () => {
+  it('embeds the pcm16 encoder only for the streaming pcm16 protocol', () => {
+    const withEncoder = buildAsrCaptureWorkletCode({ bufferSize: 4096, encodePcm16: true })
+    expect(withEncoder).toContain("registerProcessor('ndp-pcm'")
+    expect(withEncoder).toContain('(sampleRate, 16000)')
+
+    const passthrough = buildAsrCaptureWorkletCode({ bufferSize: 4096, encodePcm16: false })
+    expect(passthrough).toContain('const encode = null;')
+    expect(passthrough).not.toContain('16000)')
+  })
+})
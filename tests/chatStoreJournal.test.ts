@@ -0,0 +1,227 @@
+import { EventEmitter } from 'node:events'
+import { DatabaseSync } from 'node:sqlite'
+import { afterEach, describe, expect, it, vi } from 'vitest'
+import {
+  applyChatJournalEntries,
+  ChatStoreJournal,
+  type ChatJournalDatabase,
+  type ChatJournalEntry,
+  type ChatStoreWorker,
+  type ChatStoreWorkerFactory,
+  type ChatStoreWorkerRequest,
+  type ChatStoreWorkerResponse,
+} from '../electron/chatStoreJournal'
+
+class FakeWorker extends EventEmitter implements ChatStoreWorker {
+  readonly messages: ChatStoreWorkerRequest[] = []
+  terminateCount = 0
+  // 设为 true 时在 postMessage 内同步提交（模拟 drain 到达前批次已落盘）
+  ackSynchronously = false
+  committed: Int32Array | null = null
+
+  unref(): void {}
+
+  postMessage(message: ChatStoreWorkerRequest): void {
+    this.messages.push(message)
+    if (this.ackSynchronously && this.committed) {
+      Atomics.store(this.committed, 0, message.batchId)
+      Atomics.notify(this.committed, 0)
+    }
+  }
+
+  terminate(): Promise<number> {
+    this.terminateCount += 1
+    return Promise.resolve(0)
+  }
+
+  ack(batchId: number): void {
+    if (this.committed) {
+      Atomics.store(this.committed, 0, batchId)
+      Atomics.notify(this.committed, 0)
+    }
+    this.emit('message', { type: 'flushed', batchId } satisfies ChatStoreWorkerResponse)
+  }
+}
+
+function createHarness(options: { flushIntervalMs?: number; drainTimeoutMs?: number; factoryThrows?: boolean } = {}) {
+  const workers: FakeWorker[] = []
+  const applied: ChatJournalEntry[][] = []
+  const factory: ChatStoreWorkerFactory = vi.fn((filename, workerOptions) => {
+    expect(filename).toBe('chat-worker.js')
+    expect(workerOptions.workerData.dbPath).toBe('chat.sqlite3')
+    if (options.factoryThrows) throw new Error('worker unavailable')
+    const worker = new FakeWorker()
+    worker.committed = new Int32Array(workerOptions.workerData.sharedState)
+    workers.push(worker)
+    return worker
+  })
+  const journal = new ChatStoreJournal('chat.sqlite3', {
+    applyDirect: (entries) => applied.push(entries),
+    flushIntervalMs: options.flushIntervalMs ?? 50,
+    drainTimeoutMs: options.drainTimeoutMs ?? 200,
+    workerPath: 'chat-worker.js',
+    workerFactory: factory,
+  })
+  return { journal, workers, applied, factory }
+}
+
+function upsert(sessionId: string, messageId: string, seq: number, content = 'hi'): ChatJournalEntry {
+  return {
+    op: 'upsertMessage',
+    sessionId,
+    messageId,
+    seq,
+    role: 'assistant',
+    content,
+    createdAt: 1000 + seq,
+    updatedAt: null,
+    extra: null,
+  }
+}
+
+afterEach(() => {
+  vi.useRealTimers()
+})
+
+describe('ChatStoreJournal', () => {
+  it('batches appended entries into one flush per interval and clears them on commit', () => {
+    vi.useFakeTimers()
+    const harness = createHarness({ flushIntervalMs: 50 })
+    harness.journal.append(upsert('s1', 'm1', 0))
+    harness.journal.append(upsert('s1', 'm2', 1))
+    harness.journal.append({ op: 'touchSession', sessionId: 's1', ts: 2000 })
+
+    expect(harness.workers).toHaveLength(0)
+    expect(harness.journal.pendingFor('s1')).toHaveLength(3)
+    expect(harness.journal.pendingFor('s2')).toEqual([])
+
+    vi.advanceTimersByTime(50)
+    const worker = harness.workers[0]
+    expect(worker.messages).toHaveLength(1)
+    expect(worker.messages[0].batchId).toBe(1)
+    expect(worker.messages[0].entries).toHaveLength(3)
+    // 发送后尚未提交，读侧叠加层仍要能看到
+    expect(harness.journal.pendingFor('s1')).toHaveLength(3)
+
+    worker.ack(1)
+    expect(harness.journal.pendingFor('s1')).toEqual([])
+    expect(harness.journal.hasPending('s1')).toBe(false)
+  })
+
+  it('drain returns without fallback once the worker has committed', () => {
+    vi.useFakeTimers()
+    const harness = createHarness({ flushIntervalMs: 50 })
+    harness.journal.append(upsert('s1', 'm1', 0))
+    vi.advanceTimersByTime(50)
+    vi.useRealTimers()
+    const worker = harness.workers[0]
+    worker.ack(1)
+    worker.ackSynchronously = true
+
+    harness.journal.append(upsert('s1', 'm2', 1))
+    harness.journal.drain()
+
+    expect(harness.applied).toEqual([])
+    expect(harness.journal.pendingFor('s1')).toEqual([])
+    expect(worker.messages).toHaveLength(2)
+    expect(worker.terminateCount).toBe(0)
+  })
+
+  it('drain falls back to direct writes when the worker never commits', () => {
+    const harness = createHarness({ drainTimeoutMs: 20 })
+    const entries = [upsert('s1', 'm1', 0), { op: 'deleteMessage', sessionId: 's1', messageId: 'm0' } as const]
+    for (const entry of entries) harness.journal.append(entry)
+
+    harness.journal.drain()
+
+    expect(harness.applied).toEqual([entries])
+    expect(harness.journal.pendingFor('s1')).toEqual([])
+    expect(harness.workers[0].terminateCount).toBe(1)
+  })
+
+  it('requeues in-flight entries after a worker crash and replays them on the next flush', () => {
+    vi.useFakeTimers()
+    const harness = createHarness({ flushIntervalMs: 50 })
+    harness.journal.append(upsert('s1', 'm1', 0))
+    vi.advanceTimersByTime(50)
+    harness.workers[0].emit('exit', 1)
+
+    harness.journal.append(upsert('s1', 'm2', 1))
+    vi.advanceTimersByTime(50)
+
+    expect(harness.workers).toHaveLength(2)
+    const replay = harness.workers[1].messages[0]
+    expect(replay.batchId).toBe(2)
+    expect(replay.entries.map((entry) => (entry.op === 'upsertMessage' ? entry.messageId : ''))).toEqual(['m1', 'm2'])
+    harness.workers[1].ack(2)
+    expect(harness.journal.hasPending('s1')).toBe(false)
+  })
+
+  it('degrades to synchronous direct writes when the worker cannot start', () => {
+    vi.useFakeTimers()
+    const harness = createHarness({ factoryThrows: true })
+    harness.journal.append(upsert('s1', 'm1', 0))
+    vi.advanceTimersByTime(50)
+
+    expect(harness.applied).toEqual([[upsert('s1', 'm1', 0)]])
+    expect(harness.journal.pendingFor('s1')).toEqual([])
+
+    // 此后进入直写模式：append 立即落库，不再尝试创建线程
+    harness.journal.append(upsert('s1', 'm2', 1))
+    expect(harness.applied).toHaveLength(2)
+    expect(harness.factory).toHaveBeenCalledTimes(1)
+  })
+})
+
+describe('applyChatJournalEntries', () => {
+  it('replays the journal against a real database inside one transaction', () => {
+    const db = new DatabaseSync(':memory:')
+    db.exec(`
+      CREATE TABLE chat_session (id TEXT PRIMARY KEY, updated_at INTEGER NOT NULL);
+      CREATE TABLE chat_message (
+        session_id TEXT NOT NULL,
+        id TEXT NOT NULL,
+        seq INTEGER NOT NULL,
+        role TEXT NOT NULL,
+        content TEXT NOT NULL DEFAULT '',
+        created_at INTEGER NOT NULL,
+        updated_at INTEGER,
+        extra TEXT,
+        PRIMARY KEY (session_id, id)
+      );
+    `)
+    db.prepare('INSERT INTO chat_session (id, updated_at) VALUES (?, ?)').run('s1', 1)
+
+    const handle: ChatJournalDatabase = {
+      prepare: (sql) => ({ run: (...args) => db.prepare(sql).run(...(args as never[])) }),
+      transaction: (fn) => () => {
+        db.exec('BEGIN')
+        try {
+          fn()
+          db.exec('COMMIT')
+        } catch (error) {
+          db.exec('ROLLBACK')
+          throw error
+        }
+      },
+    }
+
+    applyChatJournalEntries(handle, [
+      upsert('s1', 'm1', 0, 'first'),
+      upsert('s1', 'm2', 1, 'second'),
+      { op: 'updateContent', sessionId: 's1', messageId: 'm1', content: 'edited', ts: 3000 },
+      { op: 'deleteMessage', sessionId: 's1', messageId: 'm2' },
+      { op: 'touchSession', sessionId: 's1', ts: 4000 },
+    ])
+
+    const rows = db.prepare('SELECT id, content, updated_at FROM chat_message ORDER BY seq').all() as Array<{
+      id: string
+      content: string
+      updated_at: number | null
+    }>
+    expect(rows).toEqual([{ id: 'm1', content: 'edited', updated_at: 3000 }])
+    const session = db.prepare('SELECT updated_at FROM chat_session WHERE id = ?').get('s1') as { updated_at: number }
+    expect(session.updated_at).toBe(4000)
+    db.close()
+  })
+})
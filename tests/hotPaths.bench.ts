@@ -0,0 +1,224 @@
+// 热路径基准（npm run bench）：固定种子生成可复现 fixtures，覆盖分句、Live2D 标签
+// 提取、聊天写回日志落盘/加载、记忆 FTS 查询构造、向量召回和 SSE 解析。结果通过
+// vitest bench 的 --outputJson 输出为机器可读 JSON，用于跨版本留基线做回归对比。
+import { DatabaseSync } from 'node:sqlite'
+import { bench, describe } from 'vitest'
+import { createStreamingSentenceSegmenter, splitTextIntoSegments } from '../src/services/textSegmentation'
+import { extractLive2DTags } from '../src/utils/live2dStream'
+import { SseStreamParser } from '../src/services/sseStream'
+import { buildMemoryFtsQuery } from '../electron/memory/memoryFtsQuery'
+import { MemoryAnnIndex, type AnnEntry } from '../electron/memory/memoryAnnIndex'
+import {
+  applyChatJournalEntries,
+  type ChatJournalDatabase,
+  type ChatJournalEntry,
+} from '../electron/chatStoreJournal'
+
+// 确定性伪随机（mulberry32）：同一种子产出同一批 fixture，保证跨运行可比
+function createRandom(seed: number): () => number {
+  let state = seed >>> 0
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0
+    let t = state
+    t = Math.imul(t ^ (t >>> 15), t | 1)
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61)
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296
+  }
+}
+
+const CJK_FRAGMENTS = ['今天的天气真是不错', '我们一起去公园散步吧', '记得带上你最喜欢的相机', '晚饭想吃什么呢', '这个问题有点复杂']
+const LATIN_FRAGMENTS = ['the quick brown fox', 'performance matters', 'streaming tokens arrive fast', 'keep latency low']
+const TAG_FRAGMENTS = ['[表情: 开心]', '[动作: 挥手]', '[表情: 惊讶]']
+
+function buildMixedText(paragraphs: number, seed: number): string {
+  const random = createRandom(seed)
+  const parts: string[] = []
+  for (let i = 0; i < paragraphs; i++) {
+    const sentences: string[] = []
+    for (let j = 0; j < 6; j++) {
+      const cjk = CJK_FRAGMENTS[Math.floor(random() * CJK_FRAGMENTS.length)]
+      const latin = LATIN_FRAGMENTS[Math.floor(random() * LATIN_FRAGMENTS.length)]
+      const tag = random() < 0.2 ? TAG_FRAGMENTS[Math.floor(random() * TAG_FRAGMENTS.length)] : ''
+      sentences.push(`${cjk}，${latin}${tag}。`)
+    }
+    parts.push(sentences.join(''))
+  }
+  return parts.join('\n')
+}
+
+function buildVector(dims: number, random: () => number): Float32Array {
+  const vec = new Float32Array(dims)
+  let norm = 0
+  for (let i = 0; i < dims; i++) {
+    vec[i] = random() * 2 - 1
+    norm += vec[i] * vec[i]
+  }
+  norm = Math.sqrt(norm) || 1
+  for (let i = 0; i < dims; i++) vec[i] /= norm
+  return vec
+}
+
+function chunked(text: string, size: number): string[] {
+  const out: string[] = []
+  for (let i = 0; i < text.length; i += size) out.push(text.slice(i, i + size))
+  return out
+}
+
+const CHAT_SCHEMA = `
+  CREATE TABLE chat_session (id TEXT PRIMARY KEY, updated_at INTEGER NOT NULL);
+  CREATE TABLE chat_message (
+    session_id TEXT NOT NULL,
+    id TEXT NOT NULL,
+    seq INTEGER NOT NULL,
+    role TEXT NOT NULL,
+    content TEXT NOT NULL DEFAULT '',
+    created_at INTEGER NOT NULL,
+    updated_at INTEGER,
+    extra TEXT,
+    PRIMARY KEY (session_id, id)
+  );
+`
+
+type BenchChatDb = ChatJournalDatabase & {
+  prepare: (sql: string) => { all: (...args: unknown[]) => unknown[]; run: (...args: unknown[]) => unknown }
+}
+
+function createChatDb(): BenchChatDb {
+  const db = new DatabaseSync(':memory:') as unknown as {
+    exec: (sql: string) => void
+    prepare: (sql: string) => { all: (...args: unknown[]) => unknown[]; run: (...args: unknown[]) => unknown }
+  }
+  db.exec(CHAT_SCHEMA)
+  db.prepare('INSERT INTO chat_session (id, updated_at) VALUES (?, ?)').run('bench-session', 1)
+  return {
+    prepare: (sql: string) => db.prepare(sql),
+    // node:sqlite 没有 better-sqlite3 的 transaction 包装，用显式 BEGIN/COMMIT 等价实现
+    transaction: (fn: () => void) => () => {
+      db.exec('BEGIN')
+      try {
+        fn()
+        db.exec('COMMIT')
+      } catch (err) {
+        db.exec('ROLLBACK')
+        throw err
+      }
+    },
+  }
+}
+
+function buildChatEntries(count: number, seed: number): ChatJournalEntry[] {
+  const random = createRandom(seed)
+  const entries: ChatJournalEntry[] = []
+  for (let i = 0; i < count; i++) {
+    entries.push({
+      op: 'upsertMessage',
+      sessionId: 'bench-session',
+      messageId: `msg-${i}`,
+      seq: i,
+      role: i % 2 === 0 ? 'user' : 'assistant',
+      content: buildMixedText(1, Math.floor(random() * 1_000_000)),
+      createdAt: 1_700_000_000_000 + i,
+      updatedAt: null,
+      extra: null,
+    })
+  }
+  return entries
+}
+
+describe('text segmentation', () => {
+  const longText = buildMixedText(400, 1)
+  const deltas = chunked(longText, 48)
+
+  bench('splitTextIntoSegments on long CJK+latin text', () => {
+    splitTextIntoSegments(longText)
+  })
+
+  bench('createStreamingSentenceSegmenter over streamed deltas', () => {
+    const segmenter = createStreamingSentenceSegmenter()
+    for (const delta of deltas) segmenter.push(delta)
+    segmenter.flush()
+  })
+})
+
+describe('live2d tag extraction', () => {
+  // 复现渲染端行为：流式期间每次 flush 都对"到目前为止的全文"重新提取标签
+  const streamedText = buildMixedText(24, 2)
+  const prefixes: string[] = []
+  for (let i = 1; i <= 64; i++) prefixes.push(streamedText.slice(0, Math.floor((streamedText.length * i) / 64)))
+
+  bench('extractLive2DTags on growing streaming buffers', () => {
+    for (const prefix of prefixes) extractLive2DTags(prefix)
+  })
+})
+
+describe('chat store journal at 10k messages', () => {
+  const entries = buildChatEntries(10_000, 3)
+  const loadedDb = createChatDb()
+  applyChatJournalEntries(loadedDb, entries)
+
+  bench('append 10k messages in 200-entry batches', () => {
+    const db = createChatDb()
+    for (let i = 0; i < entries.length; i += 200) {
+      applyChatJournalEntries(db, entries.slice(i, i + 200))
+    }
+  })
+
+  bench('load 10k messages ordered by seq', () => {
+    loadedDb
+      .prepare('SELECT id, role, content, created_at, updated_at, extra FROM chat_message WHERE session_id = ? ORDER BY seq')
+      .all('bench-session')
+  })
+})
+
+describe('memory retrieval primitives at 50k records', () => {
+  const random = createRandom(4)
+  const queries: string[] = []
+  for (let i = 0; i < 1_000; i++) {
+    const cjk = CJK_FRAGMENTS[Math.floor(random() * CJK_FRAGMENTS.length)]
+    const latin = LATIN_FRAGMENTS[Math.floor(random() * LATIN_FRAGMENTS.length)]
+    queries.push(i % 3 === 0 ? cjk : i % 3 === 1 ? latin : `${cjk} ${latin}`)
+  }
+
+  const DIMS = 256
+  const vectorRandom = createRandom(5)
+  const annEntries: AnnEntry[] = []
+  for (let i = 0; i < 50_000; i++) {
+    annEntries.push({
+      rowid: i + 1,
+      personaId: i % 4 === 0 ? null : `persona-${i % 4}`,
+      createdAt: 1_700_000_000_000 + i,
+      vec: buildVector(DIMS, vectorRandom),
+    })
+  }
+  const annIndex = MemoryAnnIndex.build('bench-model', DIMS, annEntries)
+  const queryVectors: Float32Array[] = []
+  for (let i = 0; i < 16; i++) queryVectors.push(buildVector(DIMS, vectorRandom))
+
+  bench('buildMemoryFtsQuery on 1k mixed queries', () => {
+    for (const query of queries) buildMemoryFtsQuery(query)
+  })
+
+  bench('ANN vector scoring over 50k records', () => {
+    for (const query of queryVectors) {
+      annIndex.search(query, { personaId: 'persona-1', includeShared: true, topK: 12, minScore: 0.1 })
+    }
+  })
+})
+
+describe('sse parsing throughput', () => {
+  const encoder = new TextEncoder()
+  const lines: string[] = []
+  const random = createRandom(6)
+  for (let i = 0; i < 5_000; i++) {
+    const cjk = CJK_FRAGMENTS[Math.floor(random() * CJK_FRAGMENTS.length)]
+    lines.push(`data: {"choices":[{"delta":{"content":"${cjk} token ${i}"}}]}\n\n`)
+  }
+  lines.push('data: [DONE]\n\n')
+  const networkChunks = chunked(lines.join(''), 1_536).map((part) => encoder.encode(part))
+
+  bench('SseStreamParser over a 5k-event stream', () => {
+    const parser = new SseStreamParser()
+    for (const chunk of networkChunks) parser.push(chunk)
+    parser.reset()
+  })
+})
@@ -0,0 +1,132 @@
+import { describe, expect, it, vi } from 'vitest'
+import type { Live2DModel } from 'pixi-live2d-display'
+import { createLive2dParamAccessor } from '../src/live2d/live2dParamTools'
+
+function modelWithCore(core: Record<string, unknown>): Live2DModel {
+  return { internalModel: { coreModel: core } } as unknown as Live2DModel
+}
+
+function cubism4Core() {
+  const params = [
+    { id: 'ParamAngleX', min: -30, max: 30, def: 0, value: 0 },
+    { id: 'ParamMouthOpenY', min: 0, max: 1, def: 0, value: 0 },
+  ]
+  const core = {
+    getParameterCount: vi.fn(function (this: unknown) {
+      return params.length
+    }),
+    getParameterId: vi.fn(function (this: unknown, i: number) {
+      return params[i].id
+    }),
+    getParameterMinimumValue: vi.fn(function (this: unknown, i: number) {
+      return params[i].min
+    }),
+    getParameterMaximumValue: vi.fn(function (this: unknown, i: number) {
+      return params[i].max
+    }),
+    getParameterDefaultValue: vi.fn(function (this: unknown, i: number) {
+      return params[i].def
+    }),
+    setParameterValueByIndex: vi.fn(function (this: unknown, i: number, v: number) {
+      params[i].value = v
+    }),
+    getParameterValueByIndex: vi.fn(function (this: unknown, i: number) {
+      return params[i].value
+    }),
+    setParameterValueById: vi.fn(),
+    getParameterValueById: vi.fn(() => 0.25),
+  }
+  return { core, params }
+}
+
+describe('createLive2dParamAccessor compiled parameter table', () => {
+  it('writes known parameters by numeric index without string lookups in the core', () => {
+    const { core, params } = cubism4Core()
+    const accessor = createLive2dParamAccessor(modelWithCore(core))
+
+    accessor.set('ParamMouthOpenY', 0.8)
+    accessor.set('ParamMouthOpenY', 0.2)
+    accessor.set('ParamAngleX', 12)
+
+    expect(params[1].value).toBe(0.2)
+    expect(params[0].value).toBe(12)
+    expect(core.setParameterValueByIndex).toHaveBeenCalledTimes(3)
+    expect(core.setParameterValueById).not.toHaveBeenCalled()
+    // 参数表只编译一次：后续 set 不再重新列举
+    expect(core.getParameterId).toHaveBeenCalledTimes(2)
+  })
+
+  it('clamps writes to the baked min/max range', () => {
+    const { core, params } = cubism4Core()
+    const accessor = createLive2dParamAccessor(modelWithCore(core))
+
+    accessor.set('ParamMouthOpenY', 5)
+    expect(params[1].value).toBe(1)
+    accessor.set('ParamAngleX', -999)
+    expect(params[0].value).toBe(-30)
+  })
+
+  it('falls back to the string path for ids missing from the table', () => {
+    const { core } = cubism4Core()
+    const accessor = createLive2dParamAccessor(modelWithCore(core))
+
+    accessor.set('ParamNotInModel', 1)
+    expect(core.setParameterValueById).toHaveBeenCalledWith('ParamNotInModel', 1)
+    expect(accessor.get('ParamNotInModel')).toBe(0.25)
+  })
+
+  it('reads by index and lists parameters from the compiled table', () => {
+    const { core } = cubism4Core()
+    const accessor = createLive2dParamAccessor(modelWithCore(core))
+
+    accessor.set('ParamAngleX', 7)
+    expect(accessor.get('ParamAngleX')).toBe(7)
+    expect(core.getParameterValueById).not.toHaveBeenCalled()
+
+    expect(accessor.listParameters()).toEqual([
+      { id: 'ParamAngleX', min: -30, max: 30, def: 0 },
+      { id: 'ParamMouthOpenY', min: 0, max: 1, def: 0 },
+    ])
+  })
+
+  it('retries compilation while the core reports an empty parameter list', () => {
+    const { core } = cubism4Core()
+    let ready = false
+    core.getParameterCount.mockImplementation(function (this: unknown) {
+      return ready ? 2 : 0
+    })
+    const accessor = createLive2dParamAccessor(modelWithCore(core))
+
+    expect(accessor.listParameters()).toEqual([])
+    ready = true
+    expect(accessor.listParameters()).toHaveLength(2)
+  })
+
+  it('resolves and caches cubism2 parameter indices on first use', () => {
+    const values = new Map<number, number>()
+    // 与 toCubism2ParamName 的现有输出一致（ID 映射本身沿用旧逻辑）
+    const mouthName = '_P_A_R_A_M__MOUTH_OPEN_Y'
+    const core = {
+      getParamIndex: vi.fn(function (this: unknown, name: string) {
+        return name === mouthName ? 3 : -1
+      }),
+      setParamFloat: vi.fn(function (this: unknown, indexOrName: number | string, v: number) {
+        if (typeof indexOrName === 'number') values.set(indexOrName, v)
+      }),
+      getParamFloat: vi.fn(function (this: unknown, indexOrName: number | string) {
+        return typeof indexOrName === 'number' ? (values.get(indexOrName) ?? 0) : Number.NaN
+      }),
+    }
+    const accessor = createLive2dParamAccessor(modelWithCore(core))
+
+    accessor.set('ParamMouthOpenY', 0.5)
+    accessor.set('ParamMouthOpenY', 0.9)
+    expect(values.get(3)).toBe(0.9)
+    expect(core.getParamIndex).toHaveBeenCalledTimes(1)
+    expect(accessor.get('ParamMouthOpenY')).toBe(0.9)
+
+    // 模型里不存在的参数退回名称调用（核心静默忽略）
+    accessor.set('ParamMissing', 1)
+    expect(core.setParamFloat).toHaveBeenCalledWith('_P_A_R_A_M__MISSING', 1)
+  })
+})
@@ -0,0 +1,41 @@
+import { describe, expect, it } from 'vitest'
+import {
+  LIVE2D_ACTIVE_FPS,
+  LIVE2D_IDLE_FPS,
+  resolveLive2dMaxFps,
+  type Live2dRenderActivity,
+} from '../src/live2d/live2dRenderMode'
+
+function idle(overrides: Partial<Live2dRenderActivity> = {}): Live2dRenderActivity {
+  return {
+    dragging: false,
+    mouthOpen: 0,
+    scriptRunning: false,
+    mouseSettled: true,
+    boostUntil: 0,
+    now: 10_000,
+    ...overrides,
+  }
+}
+
+describe('resolveLive2dMaxFps', () => {
+  it('drops to the idle frame rate when nothing external is active', () => {
+    expect(resolveLive2dMaxFps(idle())).toBe(LIVE2D_IDLE_FPS)
+  })
+
+  it('keeps the full frame rate for any external activity', () => {
+    expect(resolveLive2dMaxFps(idle({ dragging: true }))).toBe(LIVE2D_ACTIVE_FPS)
+    expect(resolveLive2dMaxFps(idle({ scriptRunning: true }))).toBe(LIVE2D_ACTIVE_FPS)
+    expect(resolveLive2dMaxFps(idle({ mouthOpen: 0.4 }))).toBe(LIVE2D_ACTIVE_FPS)
+    expect(resolveLive2dMaxFps(idle({ mouseSettled: false }))).toBe(LIVE2D_ACTIVE_FPS)
+  })
+
+  it('ignores lip-sync noise below the threshold', () => {
+    expect(resolveLive2dMaxFps(idle({ mouthOpen: 0.005 }))).toBe(LIVE2D_IDLE_FPS)
+  })
+
+  it('honours the boost window after a motion or expression trigger', () => {
+    expect(resolveLive2dMaxFps(idle({ boostUntil: 10_001 }))).toBe(LIVE2D_ACTIVE_FPS)
+    expect(resolveLive2dMaxFps(idle({ boostUntil: 10_000 }))).toBe(LIVE2D_IDLE_FPS)
+  })
+})
@@ -1,9 +1,9 @@
-import { afterEach, describe, expect, it } from 'vitest'
-import { mkdirSync, mkdtempSync, rmSync, symlinkSync, unlinkSync, writeFileSync } from 'node:fs'
+import { afterEach, describe, expect, it, vi } from 'vitest'
+import { mkdirSync, mkdtempSync, rmSync, symlinkSync, unlinkSync, utimesSync, writeFileSync } from 'node:fs'
 import { tmpdir } from 'node:os'
 import path from 'node:path'
 import { LocalMediaError, LocalMediaRegistry } from '../electron/localMediaRegistry'
-import { LocalMediaServer, parseSingleByteRange } from '../electron/localMediaServer'
+import { LocalMediaServer, parseSingleByteRange, pickThumbnailWidth } from '../electron/localMediaServer'
 
 const roots: string[] = []
 
@@ -113,6 +113,77 @@ describe('local media server', () => {
     expect(parseSingleByteRange('bytes=0-1,4-5', 10, 4)).toBeNull()
   })
 
+  it('snaps ?w= to thumbnail width tiers', () => {
+    expect(pickThumbnailWidth('300')).toBe(320)
+    expect(pickThumbnailWidth('480')).toBe(480)
+    expect(pickThumbnailWidth('4000')).toBe(1024)
+    expect(pickThumbnailWidth('0')).toBeNull()
+    expect(pickThumbnailWidth('abc')).toBeNull()
+    expect(pickThumbnailWidth(null)).toBeNull()
+  })
+
+  it('serves cached thumbnails for ?w= and regenerates them when the file changes', async () => {
+    const dirs = fixture()
+    const imagePath = path.join(dirs.managed, 'photo.png')
+    writeFileSync(imagePath, Buffer.alloc(64, 7))
+    utimesSync(imagePath, new Date(1_000_000), new Date(1_000_000))
+    const registry = new LocalMediaRegistry({ allowedRoots: [dirs.managed] })
+    const resizeImage = vi.fn(async (_sourcePath: string, width: number) => Buffer.from(`thumb-${width}`))
+    const server = new LocalMediaServer(registry, {
+      thumbnailDir: path.join(dirs.root, 'thumbs'),
+      resizeImage,
+    })
+
+    try {
+      const issued = await server.getUrl(imagePath)
+
+      const first = await fetch(`${issued.url}?w=300`)
+      expect(first.status).toBe(200)
+      expect(first.headers.get('content-type')).toBe('image/png')
+      expect(await first.text()).toBe('thumb-320')
+      expect(resizeImage).toHaveBeenCalledWith(expect.stringContaining('photo.png'), 320)
+
+      // 第二次命中磁盘缓存，不再触发缩放
+      const second = await fetch(`${issued.url}?w=300`)
+      expect(await second.text()).toBe('thumb-320')
+      expect(resizeImage).toHaveBeenCalledTimes(1)
+
+      // 文件内容（mtime）变化后缓存失效
+      utimesSync(imagePath, new Date(2_000_000), new Date(2_000_000))
+      const third = await fetch(`${issued.url}?w=300`)
+      expect(await third.text()).toBe('thumb-320')
+      expect(resizeImage).toHaveBeenCalledTimes(2)
+
+      // 缩放器放弃（返回 null）则回落到原图
+      resizeImage.mockResolvedValueOnce(null as unknown as Buffer)
+      utimesSync(imagePath, new Date(3_000_000), new Date(3_000_000))
+      const fallback = await fetch(`${issued.url}?w=300`)
+      expect(fallback.status).toBe(200)
+      expect((await fallback.arrayBuffer()).byteLength).toBe(64)
+    } finally {
+      await server.close()
+    }
+  })
+
+  it('ignores ?w= for videos and serves the original bytes', async () => {
+    const dirs = fixture()
+    const videoPath = path.join(dirs.managed, 'clip.mp4')
+    writeFileSync(videoPath, Buffer.from('0123456789'))
+    const registry = new LocalMediaRegistry({ allowedRoots: [dirs.managed] })
+    const resizeImage = vi.fn(async () => Buffer.from('never'))
+    const server = new LocalMediaServer(registry, { thumbnailDir: path.join(dirs.root, 'thumbs'), resizeImage })
+
+    try {
+      const issued = await server.getUrl(videoPath)
+      const response = await fetch(`${issued.url}?w=320`)
+      expect(response.status).toBe(200)
+      expect(await response.text()).toBe('0123456789')
+      expect(resizeImage).not.toHaveBeenCalled()
+    } finally {
+      await server.close()
+    }
+  })
+
   it('returns typed registry errors without exposing paths', () => {
     const error = new LocalMediaError('forbidden_path', 'Local media path is not allowed')
     expect(error.code).toBe('forbidden_path')
@@ -0,0 +1,49 @@
+import { describe, expect, it } from 'vitest'
+import { splitMarkdownBlocks } from '../src/utils/markdownBlocks'
+
+describe('splitMarkdownBlocks', () => {
+  it('splits paragraphs, headings, and fences into separate top-level blocks', () => {
+    const blocks = splitMarkdownBlocks('# Title\n\nFirst paragraph.\n\n```ts\nconst a = 1\n```\n\nSecond paragraph.')
+    expect(blocks).toEqual(['# Title', 'First paragraph.', '```ts\nconst a = 1\n```', 'Second paragraph.'])
+  })
+
+  it('never splits inside a fenced code block, even across blank lines', () => {
+    const blocks = splitMarkdownBlocks('```py\nprint(1)\n\nprint(2)\n```')
+    expect(blocks).toEqual(['```py\nprint(1)\n\nprint(2)\n```'])
+  })
+
+  it('keeps loose lists, indented code, and tables in one block', () => {
+    expect(splitMarkdownBlocks('- a\n\n- b')).toEqual(['- a\n\n- b'])
+    expect(splitMarkdownBlocks('para:\n\n    indented code')).toEqual(['para:\n\n    indented code'])
+    expect(splitMarkdownBlocks('| a | b |\n| - | - |\n\n| c | d |')).toEqual(['| a | b |\n| - | - |\n\n| c | d |'])
+  })
+
+  it('keeps closed blocks byte-stable while a stream appends to the tail', () => {
+    const full =
+      '# Answer\n\nIntro paragraph with some context.\n\n```ts\nconst x = compute()\n```\n\nClosing remark that keeps growing'
+    let previous: string[] = []
+    for (let cut = 1; cut <= full.length; cut++) {
+      const blocks = splitMarkdownBlocks(full.slice(0, cut))
+      // 除最后一个未闭合块外，之前的块必须与上一次快照逐块一致
+      for (let i = 0; i < Math.min(previous.length - 1, blocks.length - 1); i++) {
+        expect(blocks[i]).toBe(previous[i])
+      }
+      previous = blocks
+    }
+    expect(previous).toEqual([
+      '# Answer',
+      'Intro paragraph with some context.',
+      '```ts\nconst x = compute()\n```',
+      'Closing remark that keeps growing',
+    ])
+  })
+
+  it('treats an unterminated fence as the open tail block', () => {
+    expect(splitMarkdownBlocks('text\n\n```js\npartial')).toEqual(['text', '```js\npartial'])
+  })
+
+  it('returns no blocks for empty input', () => {
+    expect(splitMarkdownBlocks('')).toEqual([])
+    expect(splitMarkdownBlocks('\n\n')).toEqual([])
+  })
+})
@@ -0,0 +1,94 @@
+import { describe, expect, it } from 'vitest'
+import { MemoryAnnIndex, type AnnEntry } from '../electron/memory/memoryAnnIndex'
+
+const DIMS = 8
+
+function unitVector(angle: number): Float32Array {
+  const vec = new Float32Array(DIMS)
+  vec[0] = Math.cos(angle)
+  vec[1] = Math.sin(angle)
+  return vec
+}
+
+function entry(rowid: number, angle: number, personaId: string | null = 'p1', createdAt = rowid): AnnEntry {
+  return { rowid, personaId, createdAt, vec: unitVector(angle) }
+}
+
+function buildEntries(count: number): AnnEntry[] {
+  const entries: AnnEntry[] = []
+  for (let i = 0; i < count; i++) entries.push(entry(i + 1, (i / count) * Math.PI))
+  return entries
+}
+
+describe('MemoryAnnIndex', () => {
+  it('returns the exact nearest neighbours with persona filtering and minScore', () => {
+    const index = MemoryAnnIndex.build('vector-model', DIMS, [
+      entry(1, 0),
+      entry(2, 0.1),
+      entry(3, Math.PI / 2),
+      entry(4, 0.05, null),
+      entry(5, 0.02, 'other'),
+    ])
+
+    const hits = index.search(unitVector(0), { personaId: 'p1', includeShared: true, topK: 3, minScore: 0.5 })
+    expect(hits.map((hit) => hit.rowid)).toEqual([1, 4, 2])
+    expect(hits[0].sim).toBeCloseTo(1, 5)
+
+    const ownOnly = index.search(unitVector(0), { personaId: 'p1', includeShared: false, topK: 3, minScore: 0.5 })
+    expect(ownOnly.map((hit) => hit.rowid)).toEqual([1, 2])
+  })
+
+  it('keeps good recall on a clustered corpus while probing a subset of lists', () => {
+    const entries = buildEntries(2000)
+    const index = MemoryAnnIndex.build('vector-model', DIMS, entries)
+
+    const query = unitVector(0.25 * Math.PI)
+    const exact = entries
+      .map((e) => ({ rowid: e.rowid, sim: e.vec[0] * query[0] + e.vec[1] * query[1] }))
+      .sort((a, b) => b.sim - a.sim || b.rowid - a.rowid)
+      .slice(0, 10)
+      .map((hit) => hit.rowid)
+    const approx = index
+      .search(query, { personaId: 'p1', includeShared: true, topK: 10, minScore: -1 })
+      .map((hit) => hit.rowid)
+
+    const overlap = approx.filter((rowid) => exact.includes(rowid)).length
+    expect(overlap).toBeGreaterThanOrEqual(9)
+  })
+
+  it('supports incremental insert and remove after the initial build', () => {
+    const index = MemoryAnnIndex.build('vector-model', DIMS, buildEntries(100))
+    expect(index.size).toBe(100)
+
+    index.insert(entry(500, 0.01))
+    expect(index.has(500)).toBe(true)
+    expect(
+      index.search(unitVector(0), { personaId: 'p1', includeShared: true, topK: 1, minScore: 0 })[0]?.rowid,
+    ).toBe(500)
+
+    expect(index.remove(500)).toBe(true)
+    expect(index.remove(500)).toBe(false)
+    expect(index.size).toBe(100)
+    expect(
+      index.search(unitVector(0), { personaId: 'p1', includeShared: true, topK: 1, minScore: 0 })[0]?.rowid,
+    ).not.toBe(500)
+  })
+
+  it('round-trips through serialize/deserialize including watermark and shared entries', () => {
+    const index = MemoryAnnIndex.build('vector-model', DIMS, [entry(1, 0), entry(2, 0.3, null), entry(3, 1.2)])
+    index.watermark = 12345
+
+    const restored = MemoryAnnIndex.deserialize(index.serialize())
+    expect(restored.model).toBe('vector-model')
+    expect(restored.dims).toBe(DIMS)
+    expect(restored.watermark).toBe(12345)
+    expect(restored.size).toBe(3)
+    expect(restored.search(unitVector(0), { personaId: 'p1', includeShared: true, topK: 3, minScore: 0 })).toEqual(
+      index.search(unitVector(0), { personaId: 'p1', includeShared: true, topK: 3, minScore: 0 }),
+    )
+  })
+
+  it('rejects foreign file contents instead of loading garbage', () => {
+    expect(() => MemoryAnnIndex.deserialize(Buffer.from('not an index file'))).toThrow('ANN 索引文件头无效')
+  })
+})
@@ -6,6 +6,8 @@ import { afterEach, describe, expect, it } from 'vitest'
 import {
   initializeMemoryDatabase,
   openMemoryDatabase,
+  pickMemoryCacheProfile,
+  preparedStatement,
   type MemoryDatabaseConstructor,
   type MemoryDatabaseHandle,
 } from '../electron/memory/memoryDatabase'
@@ -151,6 +153,7 @@ describe('Memory database lifecycle', () => {
         .run('fresh-memory', 'default', 'persona', 'chat', 'user', 'session-1', 'message-1', 'fresh searchable memory', 100)
       expect(ftsRowids(opened.db, 'memory_fts', 'searchable')).toEqual([Number(inserted.lastInsertRowid)])
     } finally {
+      opened.readDb.close()
       opened.db.close()
     }
   })
@@ -236,6 +239,7 @@ describe('Memory database lifecycle', () => {
       expect(indexes.has('idx_memory_kind_persona_updated')).toBe(true)
       expect(indexes.has('idx_memory_persona_status_pinned_created')).toBe(true)
     } finally {
+      opened.readDb.close()
       opened.db.close()
     }
   })
@@ -272,6 +276,7 @@ describe('Memory database lifecycle', () => {
       opened.db.prepare('DELETE FROM memory WHERE rowid = ?').run(rowid)
       expect(ftsRowids(opened.db, 'memory_fts', 'after')).toEqual([])
     } finally {
+      opened.readDb.close()
       opened.db.close()
     }
   })
@@ -305,6 +310,52 @@ describe('Memory database lifecycle', () => {
       expect(ftsRowids(opened.db, 'kg_entity_fts', 'Ally')).toEqual([])
       expect(ftsRowids(opened.db, 'kg_entity_fts', 'Alicia')).toEqual([1])
     } finally {
+      opened.readDb.close()
+      opened.db.close()
+    }
+  })
+
+  it('picks page-cache profiles by database size', () => {
+    expect(pickMemoryCacheProfile(0)).toEqual({ cacheKib: 4_096, mmapBytes: 32 * 1024 * 1024 })
+    expect(pickMemoryCacheProfile(64 * 1024 * 1024)).toEqual({ cacheKib: 16_384, mmapBytes: 128 * 1024 * 1024 })
+    expect(pickMemoryCacheProfile(1024 * 1024 * 1024)).toEqual({ cacheKib: 65_536, mmapBytes: 256 * 1024 * 1024 })
+  })
+
+  it('tunes the page cache and exposes a read-only second connection that sees writer rows', async () => {
+    const dir = await tempDir()
+    const opened = openTestMemoryDatabase(dir, () => 500)
+
+    try {
+      // 新库落在最小档位：4 MiB 页缓存（cache_size 负值 = KiB）
+      expect(opened.db.pragma('cache_size', { simple: true })).toBe(-4_096)
+      expect(opened.readDb.pragma('cache_size', { simple: true })).toBe(-4_096)
+      expect(opened.readDb.pragma('query_only', { simple: true })).toBe(1)
+
+      opened.db
+        .prepare('INSERT INTO memory (id, persona_id, scope, kind, role, content, created_at) VALUES (?, ?, ?, ?, ?, ?, ?)')
+        .run('visible-memory', 'default', 'persona', 'chat', 'user', 'written on the writer connection', 100)
+      expect(opened.readDb.prepare('SELECT content as content FROM memory WHERE id = ?').get('visible-memory')).toEqual({
+        content: 'written on the writer connection',
+      })
+      expect(() => opened.readDb.prepare('DELETE FROM memory WHERE id = ?').run('visible-memory')).toThrow()
+    } finally {
+      opened.readDb.close()
+      opened.db.close()
+    }
+  })
+
+  it('prepares each fixed SQL statement once per connection', async () => {
+    const dir = await tempDir()
+    const opened = openTestMemoryDatabase(dir)
+
+    try {
+      const sql = 'SELECT id as id FROM persona WHERE id = ?'
+      const first = preparedStatement(opened.db, sql)
+      expect(preparedStatement(opened.db, sql)).toBe(first)
+      expect(preparedStatement(opened.readDb, sql)).not.toBe(first)
+      expect(first.get('default')).toEqual({ id: 'default' })
+    } finally {
+      opened.readDb.close()
       opened.db.close()
     }
   })
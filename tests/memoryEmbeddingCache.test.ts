@@ -0,0 +1,168 @@
+import { createRequire } from 'node:module'
+import { afterEach, describe, expect, it, vi } from 'vitest'
+import type { MemoryDatabaseHandle } from '../electron/memory/memoryDatabase'
+import { MemoryEmbeddingCacheStore } from '../electron/memory/memoryEmbeddingCache'
+import { MemoryEmbeddingClient, hashMemoryEmbeddingInput } from '../electron/memory/memoryEmbeddingClient'
+
+type NodeDatabase = {
+  exec: (source: string) => void
+  prepare: (source: string) => {
+    all: (...params: unknown[]) => Record<string, unknown>[]
+    get: (...params: unknown[]) => Record<string, unknown> | undefined
+    run: (...params: unknown[]) => unknown
+  }
+  close: () => void
+}
+
+const require = createRequire(import.meta.url)
+const { DatabaseSync } = require('node:sqlite') as {
+  DatabaseSync: new (file: string) => NodeDatabase
+}
+
+class NodeDatabaseAdapter {
+  private readonly db = new DatabaseSync(':memory:')
+
+  exec(source: string): void {
+    this.db.exec(source)
+  }
+
+  prepare(source: string): ReturnType<MemoryDatabaseHandle['prepare']> {
+    return this.db.prepare(source) as unknown as ReturnType<MemoryDatabaseHandle['prepare']>
+  }
+
+  transaction<TArgs extends unknown[], TResult>(fn: (...args: TArgs) => TResult): (...args: TArgs) => TResult {
+    return (...args) => {
+      this.db.exec('BEGIN')
+      try {
+        const result = fn(...args)
+        this.db.exec('COMMIT')
+        return result
+      } catch (error) {
+        this.db.exec('ROLLBACK')
+        throw error
+      }
+    }
+  }
+
+  close(): void {
+    this.db.close()
+  }
+}
+
+const databases: NodeDatabaseAdapter[] = []
+
+afterEach(() => {
+  for (const db of databases.splice(0)) db.close()
+})
+
+function createDb(): MemoryDatabaseHandle {
+  const adapter = new NodeDatabaseAdapter()
+  databases.push(adapter)
+  adapter.exec(`
+    CREATE TABLE embedding_cache (
+      model TEXT NOT NULL,
+      content_hash TEXT NOT NULL,
+      dims INTEGER NOT NULL,
+      embedding BLOB NOT NULL,
+      created_at INTEGER NOT NULL,
+      last_used_at INTEGER NOT NULL,
+      PRIMARY KEY(model, content_hash)
+    );
+  `)
+  return adapter as unknown as MemoryDatabaseHandle
+}
+
+function vec(seed: number): Float32Array {
+  const out = new Float32Array(8)
+  out[0] = seed
+  out[1] = 1
+  return out
+}
+
+describe('MemoryEmbeddingCacheStore', () => {
+  it('round-trips vectors keyed by model and hash, missing keys stay absent', () => {
+    const store = new MemoryEmbeddingCacheStore(createDb(), { now: () => 100 })
+    store.putMany('model-a', [
+      { hash: 'h1', vec: vec(1) },
+      { hash: 'h2', vec: vec(2) },
+    ])
+
+    const hits = store.getMany('model-a', ['h1', 'h2', 'h3'])
+    expect([...hits.keys()].sort()).toEqual(['h1', 'h2'])
+    expect(hits.get('h1')).toEqual(vec(1))
+
+    expect(store.getMany('model-b', ['h1']).size).toBe(0)
+  })
+
+  it('evicts the least recently used entries beyond maxEntries', () => {
+    const db = createDb()
+    let clock = 0
+    const store = new MemoryEmbeddingCacheStore(db, { maxEntries: 2, now: () => ++clock })
+    store.putMany('model-a', [{ hash: 'old', vec: vec(1) }])
+    store.putMany('model-a', [{ hash: 'mid', vec: vec(2) }])
+    store.getMany('model-a', ['old'])
+    store.putMany('model-a', [{ hash: 'new', vec: vec(3) }])
+
+    const remaining = (db.prepare('SELECT content_hash as hash FROM embedding_cache ORDER BY content_hash').all() as Array<{
+      hash: string
+    }>).map((row) => row.hash)
+    expect(remaining).toEqual(['new', 'old'])
+  })
+})
+
+describe('MemoryEmbeddingClient persistent cache integration', () => {
+  const config = { model: 'vector-model', apiKey: 'key', endpoint: 'https://vector.example/v1/embeddings' }
+
+  it('skips the network entirely when the persistent cache has the hash', async () => {
+    const store = new MemoryEmbeddingCacheStore(createDb(), { now: () => 100 })
+    const hash = hashMemoryEmbeddingInput(config.model, 'Cached greeting')
+    store.putMany(config.model, [{ hash, vec: vec(7) }])
+
+    const fetchImpl = vi.fn()
+    const client = new MemoryEmbeddingClient({ fetchImpl, persistentCache: store })
+    const embedded = await client.embedTexts(config, ['Cached greeting'])
+    expect(fetchImpl).not.toHaveBeenCalled()
+    expect(embedded).toEqual([{ text: 'Cached greeting', hash, vec: vec(7) }])
+  })
+
+  it('stores fresh embeddings so a second client instance avoids the round-trip', async () => {
+    const db = createDb()
+    const fetchImpl = vi.fn(async () =>
+      new Response(JSON.stringify({ data: [{ index: 0, embedding: [0, 1, 0, 0, 0, 0, 0, 0] }] }), { status: 200 }),
+    )
+    const first = new MemoryEmbeddingClient({
+      fetchImpl,
+      persistentCache: new MemoryEmbeddingCacheStore(db, { now: () => 100 }),
+    })
+    await first.embedTexts(config, ['Persona boilerplate'])
+    expect(fetchImpl).toHaveBeenCalledTimes(1)
+
+    const second = new MemoryEmbeddingClient({
+      fetchImpl,
+      persistentCache: new MemoryEmbeddingCacheStore(db, { now: () => 200 }),
+    })
+    const embedded = await second.embedTexts(config, ['Persona boilerplate'])
+    expect(fetchImpl).toHaveBeenCalledTimes(1)
+    expect(embedded[0].vec[1]).toBeCloseTo(1, 5)
+  })
+
+  it('degrades to the network when the persistent cache throws', async () => {
+    const fetchImpl = vi.fn(async () =>
+      new Response(JSON.stringify({ data: [{ index: 0, embedding: [0, 1, 0, 0, 0, 0, 0, 0] }] }), { status: 200 }),
+    )
+    const client = new MemoryEmbeddingClient({
+      fetchImpl,
+      persistentCache: {
+        getMany: () => {
+          throw new Error('disk io error')
+        },
+        putMany: () => {
+          throw new Error('disk io error')
+        },
+      },
+    })
+    const embedded = await client.embedTexts(config, ['Unlucky text'])
+    expect(fetchImpl).toHaveBeenCalledTimes(1)
+    expect(embedded).toHaveLength(1)
+  })
+})
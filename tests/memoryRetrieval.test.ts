@@ -232,7 +232,7 @@ describe('MemoryRetrievalEngine', () => {
     expect(result.addon.match(/Alice likes Tea/g)).toHaveLength(1)
   })
 
-  it('uses vector retrieval only when local candidates are insufficient', async () => {
+  it('fans out the vector leg alongside the SQL legs and fuses its hits', async () => {
     const embedTexts = vi.fn(async () => [
       { text: 'semantic beacon recollection', hash: 'query-hash', vec: new Float32Array([1, 0]) },
     ])
@@ -270,6 +270,43 @@ describe('MemoryRetrievalEngine', () => {
     expect(result.addon).toContain('A cobalt lighthouse watches the sea.')
   })
 
+  it('skips the tag and KG expansion legs when the vector leg lands confidently first', async () => {
+    const embedTexts = vi.fn(async () => [
+      { text: 'alice', hash: 'query-hash', vec: new Float32Array([1, 0]) },
+    ])
+    const harness = createHarness({
+      now: 2_000,
+      vectorSearch: vi.fn(async () => [
+        { rowid: 1, sim: 0.92 },
+        { rowid: 2, sim: 0.9 },
+      ]),
+      embedTexts,
+    })
+    const rowidA = insertMemory(harness.db, 'Alice likes tea', { createdAt: 1_500 })
+    insertMemory(harness.db, 'Alice likes hiking', { createdAt: 1_600 })
+    const tagId = Number(harness.db.prepare('INSERT INTO tag (name, created_at) VALUES (?, ?)').run('alice', 1).lastInsertRowid)
+    harness.db.prepare('INSERT INTO memory_tag (memory_rowid, tag_id, created_at) VALUES (?, ?, ?)').run(rowidA, tagId, 1)
+
+    const result = await harness.engine.retrieve(
+      { personaId: 'persona-a', query: 'alice', limit: 2, reinforce: false },
+      {
+        tagEnabled: true,
+        kgEnabled: true,
+        vectorEnabled: true,
+        vectorEmbeddingModel: 'vector-model',
+        vectorUseCustomAi: true,
+        vectorAiApiKey: 'vector-key',
+        vectorAiBaseUrl: 'https://vector.example/v1',
+      } as MemorySettings,
+      {} as AISettings,
+    )
+
+    expect(result.debug).toMatchObject({
+      counts: { tag: 0, kg: 0, vector: 2 },
+      vector: { enabled: true, attempted: true, earlyExit: true },
+    })
+  })
+
   it('reports vector failures without losing the persona addon', async () => {
     const embedTexts = vi.fn(async () => [
       { text: 'unknown', hash: 'query-hash', vec: new Float32Array([1, 0]) },
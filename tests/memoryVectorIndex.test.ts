@@ -172,6 +172,63 @@ describe('MemoryVectorIndexMaintainer', () => {
     ).toEqual({ count: 0 })
   })
 
+  it('splits large batches into concurrent /embeddings requests with bounded fan-out', async () => {
+    let inFlight = 0
+    let maxInFlight = 0
+    const fetchImpl = vi.fn(async (_input: string | URL | Request, init?: RequestInit) => {
+      inFlight++
+      maxInFlight = Math.max(maxInFlight, inFlight)
+      await new Promise((resolve) => setTimeout(resolve, 5))
+      const payload = JSON.parse(String(init?.body)) as { input: string[] }
+      inFlight--
+      return new Response(
+        JSON.stringify({ data: payload.input.map((_, index) => ({ index, embedding: vector(1) })) }),
+        { status: 200 },
+      )
+    })
+    const harness = createHarness(fetchImpl)
+    const insert = harness.db.prepare('INSERT INTO memory (content, updated_at) VALUES (?, ?)')
+    for (let i = 0; i < 6; i++) insert.run(`Memory entry ${i}`, 100 + i)
+
+    await expect(
+      harness.maintainer.run(harness.memSettings, harness.aiSettings, {
+        batchSize: 6,
+        requestBatchSize: 2,
+        concurrency: 2,
+      }),
+    ).resolves.toEqual({ scanned: 6, embedded: 6, skipped: 0 })
+    expect(fetchImpl).toHaveBeenCalledTimes(3)
+    expect(maxInFlight).toBeLessThanOrEqual(2)
+    expect(harness.db.prepare('SELECT COUNT(*) as count FROM memory_embedding').get()).toEqual({ count: 6 })
+  })
+
+  it('persists successful chunks and reports the first error when one chunk fails', async () => {
+    let calls = 0
+    const fetchImpl = vi.fn(async (_input: string | URL | Request, init?: RequestInit) => {
+      calls++
+      if (calls === 2) {
+        return new Response(JSON.stringify({ error: { message: 'rate limited' } }), { status: 429 })
+      }
+      const payload = JSON.parse(String(init?.body)) as { input: string[] }
+      return new Response(
+        JSON.stringify({ data: payload.input.map((_, index) => ({ index, embedding: vector(1) })) }),
+        { status: 200 },
+      )
+    })
+    const harness = createHarness(fetchImpl)
+    const insert = harness.db.prepare('INSERT INTO memory (content, updated_at) VALUES (?, ?)')
+    for (let i = 0; i < 3; i++) insert.run(`Chunked entry ${i}`, 100 + i)
+
+    await expect(
+      harness.maintainer.run(harness.memSettings, harness.aiSettings, {
+        batchSize: 3,
+        requestBatchSize: 1,
+        concurrency: 1,
+      }),
+    ).resolves.toEqual({ scanned: 3, embedded: 2, skipped: 0, error: 'rate limited' })
+    expect(harness.db.prepare('SELECT COUNT(*) as count FROM memory_embedding').get()).toEqual({ count: 2 })
+  })
+
   it('reports provider errors without writing a partial embedding row', async () => {
     const fetchImpl = vi.fn(async () =>
       new Response(JSON.stringify({ error: { message: 'embedding service offline' } }), { status: 503 }),
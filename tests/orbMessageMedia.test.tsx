@@ -16,7 +16,7 @@ import {
 function createMediaApi() {
   return {
     readChatAttachmentDataUrl: vi.fn(async () => ({ ok: true as const, dataUrl: 'data:image/png;base64,orb' })),
-    getChatAttachmentUrl: vi.fn(async () => ({ ok: true as const, url: 'http://127.0.0.1/orb-video' })),
+    getChatAttachmentUrl: vi.fn(async () => ({ ok: true as const, url: 'http://127.0.0.1:34567/media/orb-token' })),
   }
 }
 
@@ -36,29 +36,42 @@ describe('Orb message media', () => {
   it('resolves local image and video references through the media API', async () => {
     const api = createMediaApi()
 
+    // 图片预览拿的是缩略图 URL，而不是整图 data URL
     await expect(
       resolveOrbImageSource(api as unknown as NeoDeskPetApi, {
         imagePath: 'attachments/orb.png',
         resourceId: 'image-resource',
       }),
-    ).resolves.toBe('data:image/png;base64,orb')
-    expect(api.readChatAttachmentDataUrl).toHaveBeenCalledWith({
+    ).resolves.toBe('http://127.0.0.1:34567/media/orb-token?w=480')
+    expect(api.getChatAttachmentUrl).toHaveBeenCalledWith({
       resourceId: 'image-resource',
       path: 'attachments/orb.png',
     })
+    expect(api.readChatAttachmentDataUrl).not.toHaveBeenCalled()
 
     await expect(
       resolveOrbVideoSource(api as unknown as NeoDeskPetApi, {
         videoPath: 'attachments/orb.mp4',
         resourceId: 'video-resource',
       }),
-    ).resolves.toBe('http://127.0.0.1/orb-video')
+    ).resolves.toBe('http://127.0.0.1:34567/media/orb-token')
     expect(api.getChatAttachmentUrl).toHaveBeenCalledWith({
       resourceId: 'video-resource',
       path: 'attachments/orb.mp4',
     })
   })
 
+  it('falls back to the full data URL when the media server has no URL for the image', async () => {
+    const api = {
+      readChatAttachmentDataUrl: vi.fn(async () => ({ ok: true as const, dataUrl: 'data:image/png;base64,orb' })),
+      getChatAttachmentUrl: vi.fn(async () => ({ ok: false as const, error: 'unavailable' })),
+    }
+    await expect(
+      resolveOrbImageSource(api as unknown as NeoDeskPetApi, { imagePath: 'attachments/orb.png' }),
+    ).resolves.toBe('data:image/png;base64,orb')
+    expect(api.readChatAttachmentDataUrl).toHaveBeenCalledWith('attachments/orb.png')
+  })
+
   it('uses direct media sources immediately and clears failed local resolutions', async () => {
     const api = createMediaApi()
     const imageUrl = 'https://example.com/orb.png'
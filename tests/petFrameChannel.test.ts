@@ -0,0 +1,85 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest'
+import { createPetFrameBatcher, decodePetFrame, encodePetFrame } from '../electron/petFrameChannel'
+
+describe('pet frame channel', () => {
+  it('round-trips a full frame through the binary layout', () => {
+    const payload = {
+      mouseTarget: { x: -0.25, y: 0.75, t: 1_700_000_000_123 },
+      cursorProbe: { x: 42, y: 17 },
+    }
+    expect(decodePetFrame(encodePetFrame(payload))).toEqual(payload)
+  })
+
+  it('encodes only the fields that are present', () => {
+    const frame = encodePetFrame({ cursorProbe: { x: 3, y: 4 } })
+    const decoded = decodePetFrame(frame)
+    expect(decoded.mouseTarget).toBeUndefined()
+    expect(decoded.cursorProbe).toEqual({ x: 3, y: 4 })
+  })
+
+  it('decodes from both ArrayBuffer and typed-array views', () => {
+    const frame = encodePetFrame({ mouseTarget: { x: 1, y: -1, t: 5 } })
+    expect(decodePetFrame(frame.buffer.slice(0))).toEqual(decodePetFrame(frame))
+  })
+
+  it('returns an empty payload for undersized frames', () => {
+    expect(decodePetFrame(new Uint8Array(8))).toEqual({})
+  })
+
+  describe('batcher', () => {
+    beforeEach(() => {
+      vi.useFakeTimers()
+    })
+
+    afterEach(() => {
+      vi.useRealTimers()
+    })
+
+    it('coalesces writes within one frame window into a single message', () => {
+      const sent: Uint8Array[] = []
+      const batcher = createPetFrameBatcher((frame) => sent.push(frame), 16)
+
+      batcher.set({ mouseTarget: { x: 0.1, y: 0.1, t: 1 } })
+      batcher.set({ mouseTarget: { x: 0.2, y: 0.2, t: 2 } })
+      batcher.set({ cursorProbe: { x: 10, y: 20 } })
+      expect(sent).toHaveLength(0)
+
+      vi.advanceTimersByTime(16)
+      expect(sent).toHaveLength(1)
+      expect(decodePetFrame(sent[0])).toEqual({
+        mouseTarget: { x: 0.2, y: 0.2, t: 2 },
+        cursorProbe: { x: 10, y: 20 },
+      })
+    })
+
+    it('sends separate frames for writes in different frame windows', () => {
+      const sent: Uint8Array[] = []
+      const batcher = createPetFrameBatcher((frame) => sent.push(frame), 16)
+
+      batcher.set({ mouseTarget: { x: 1, y: 1, t: 1 } })
+      vi.advanceTimersByTime(16)
+      batcher.set({ mouseTarget: { x: 2, y: 2, t: 2 } })
+      vi.advanceTimersByTime(16)
+
+      expect(sent).toHaveLength(2)
+      expect(decodePetFrame(sent[1]).mouseTarget).toEqual({ x: 2, y: 2, t: 2 })
+    })
+
+    it('flush sends pending fields immediately and close stops further sends', () => {
+      const sent: Uint8Array[] = []
+      const batcher = createPetFrameBatcher((frame) => sent.push(frame), 16)
+
+      batcher.set({ cursorProbe: { x: 1, y: 2 } })
+      batcher.flush()
+      expect(sent).toHaveLength(1)
+
+      vi.advanceTimersByTime(32)
+      expect(sent).toHaveLength(1)
+
+      batcher.close()
+      batcher.set({ cursorProbe: { x: 9, y: 9 } })
+      vi.advanceTimersByTime(32)
+      expect(sent).toHaveLength(1)
+    })
+  })
+})
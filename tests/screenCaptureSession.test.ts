@@ -0,0 +1,120 @@
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest'
+import { EventEmitter } from 'node:events'
+import { ScreenCaptureSession, type ScreenCaptureHelperProcess } from '../electron/screenCaptureService'
+
+type FakeRequest = { id: number; op: string } & Record<string, unknown>
+
+/** 模拟常驻 helper：记录收到的行式 JSON 请求，由测试决定何时/以何种顺序应答 */
+class FakeHelper extends EventEmitter {
+  // 不设 pid：避免会话清理时对测试机上的无关进程调用 killProcessTree
+  requests: FakeRequest[] = []
+  stdout = new EventEmitter()
+  stdin = {
+    write: (chunk: string) => {
+      for (const line of chunk.split('\n')) {
+        if (line.trim()) this.requests.push(JSON.parse(line) as FakeRequest)
+      }
+      return true
+    },
+  }
+
+  reply(payload: Record<string, unknown>): void {
+    this.stdout.emit('data', Buffer.from(`${JSON.stringify(payload)}\n`, 'utf8'))
+  }
+
+  asProcess(): ScreenCaptureHelperProcess {
+    return this as unknown as ScreenCaptureHelperProcess
+  }
+}
+
+describe('ScreenCaptureSession', () => {
+  let helpers: FakeHelper[]
+  let session: ScreenCaptureSession
+
+  const spawnHelper = () => {
+    const helper = new FakeHelper()
+    helpers.push(helper)
+    return helper.asProcess()
+  }
+
+  beforeEach(() => {
+    helpers = []
+    session = new ScreenCaptureSession({ spawnHelper })
+  })
+
+  afterEach(() => {
+    session.dispose()
+    vi.useRealTimers()
+  })
+
+  it('serves requests over one long-lived helper and matches replies by id', async () => {
+    const first = session.request('snapshot', {})
+    const second = session.request('capture', { x: 0, y: 0, w: 8, h: 8, out: 'a.png' })
+    expect(helpers).toHaveLength(1)
+    const helper = helpers[0]
+    expect(helper.requests.map((r) => r.op)).toEqual(['snapshot', 'capture'])
+
+    // ready 行与乱序应答都要正确路由
+    helper.reply({ ready: true })
+    helper.reply({ id: helper.requests[1].id, ok: true })
+    helper.reply({ id: helper.requests[0].id, ok: true, result: { displays: [], cursor: { x: 1, y: 2 } } })
+
+    await expect(second).resolves.toBeUndefined()
+    await expect(first).resolves.toEqual({ displays: [], cursor: { x: 1, y: 2 } })
+    expect(helpers).toHaveLength(1)
+  })
+
+  it('rejects with the helper error message when ok is false', async () => {
+    const req = session.request('capture', { x: 0, y: 0, w: 8, h: 8, out: 'a.png' })
+    helpers[0].reply({ id: helpers[0].requests[0].id, ok: false, error: '保存失败' })
+    await expect(req).rejects.toThrow('保存失败')
+  })
+
+  it('rebuilds the session after a request timeout', async () => {
+    const req = session.request('snapshot', {}, { timeoutMs: 15 })
+    await expect(req).rejects.toThrow(/timeout/)
+    expect(session.isRunning()).toBe(false)
+
+    const retry = session.request('snapshot', {})
+    expect(helpers).toHaveLength(2)
+    helpers[1].reply({ id: helpers[1].requests[0].id, ok: true, result: { displays: [] } })
+    await expect(retry).resolves.toEqual({ displays: [] })
+  })
+
+  it('fails in-flight requests when the helper exits and respawns on demand', async () => {
+    const req = session.request('snapshot', {})
+    helpers[0].emit('close')
+    await expect(req).rejects.toThrow(/已退出/)
+
+    const retry = session.request('snapshot', {})
+    expect(helpers).toHaveLength(2)
+    helpers[1].reply({ id: helpers[1].requests[0].id, ok: true, result: { displays: [] } })
+    await expect(retry).resolves.toEqual({ displays: [] })
+  })
+
+  it('shuts the idle helper down and restarts it for the next request', async () => {
+    vi.useFakeTimers()
+    const idleSession = new ScreenCaptureSession({ spawnHelper, idleTimeoutMs: 1000 })
+
+    const req = idleSession.request('snapshot', {})
+    helpers[0].reply({ id: helpers[0].requests[0].id, ok: true, result: { displays: [] } })
+    await expect(req).resolves.toEqual({ displays: [] })
+    expect(idleSession.isRunning()).toBe(true)
+
+    vi.advanceTimersByTime(1100)
+    expect(idleSession.isRunning()).toBe(false)
+
+    const next = idleSession.request('snapshot', {})
+    expect(helpers).toHaveLength(2)
+    idleSession.dispose()
+    await expect(next).rejects.toThrow(/已关闭/)
+  })
+
+  it('aborting a request tears the session down immediately', async () => {
+    const ac = new AbortController()
+    const req = session.request('capture', { x: 0, y: 0, w: 8, h: 8, out: 'a.png' }, { signal: ac.signal })
+    ac.abort()
+    await expect(req).rejects.toThrow(/canceled/)
+    expect(session.isRunning()).toBe(false)
+  })
+})
@@ -0,0 +1,166 @@
+import { createRequire } from 'node:module'
+import { afterEach, describe, expect, it, vi } from 'vitest'
+import { STALE_REFRESH_DELAY_MS, SemanticGroupManager } from '../electron/semanticGroupManager'
+
+type NodeStatement = {
+  all: (...params: unknown[]) => Record<string, unknown>[]
+  get: (...params: unknown[]) => Record<string, unknown> | undefined
+  run: (...params: unknown[]) => unknown
+}
+
+type NodeDatabase = {
+  exec: (source: string) => void
+  prepare: (source: string) => NodeStatement
+  close: () => void
+}
+
+const require = createRequire(import.meta.url)
+const { DatabaseSync } = require('node:sqlite') as {
+  DatabaseSync: new (file: string) => NodeDatabase
+}
+
+class NodeDatabaseAdapter {
+  private readonly db = new DatabaseSync(':memory:')
+
+  exec(source: string): void {
+    this.db.exec(source)
+  }
+
+  prepare(source: string): NodeStatement {
+    return this.db.prepare(source)
+  }
+
+  transaction<TArgs extends unknown[], TResult>(fn: (...args: TArgs) => TResult): (...args: TArgs) => TResult {
+    return (...args) => {
+      this.db.exec('BEGIN')
+      try {
+        const result = fn(...args)
+        this.db.exec('COMMIT')
+        return result
+      } catch (error) {
+        this.db.exec('ROLLBACK')
+        throw error
+      }
+    }
+  }
+
+  close(): void {
+    this.db.close()
+  }
+}
+
+const databases: NodeDatabaseAdapter[] = []
+
+afterEach(() => {
+  vi.useRealTimers()
+  for (const db of databases.splice(0)) db.close()
+})
+
+function createHarness() {
+  const adapter = new NodeDatabaseAdapter()
+  databases.push(adapter)
+  const embedded: string[] = []
+  const manager = new SemanticGroupManager(
+    adapter as unknown as ConstructorParameters<typeof SemanticGroupManager>[0],
+    async (text) => {
+      embedded.push(text)
+      return Array.from({ length: 8 }, (_, i) => i + 1)
+    },
+  )
+  return { manager, embedded }
+}
+
+describe('SemanticGroupManager', () => {
+  it('caches the group list and patches activation stats in place', () => {
+    const { manager } = createHarness()
+    manager.createGroup({ name: '咖啡', words: ['alpha', '拿铁'] })
+
+    const first = manager.getAllGroups()
+    expect(manager.getAllGroups()).toBe(first)
+
+    const activations = manager.detectActivatedGroups('今天喝了一杯拿铁')
+    expect(activations).toHaveLength(1)
+    expect(activations[0].matchedWords).toEqual(['拿铁'])
+
+    // 激活统计原地更新缓存，不触发整表重读
+    expect(manager.getAllGroups()).toBe(first)
+    expect(manager.getGroup('咖啡')!.activationCount).toBe(1)
+  })
+
+  it('invalidates the matcher cache when group words change', () => {
+    const { manager } = createHarness()
+    manager.createGroup({ name: 'g', words: ['alpha'] })
+    expect(manager.detectActivatedGroups('ALPHA test')).toHaveLength(1)
+
+    manager.updateGroup({ name: 'g', words: ['beta'] })
+    expect(manager.detectActivatedGroups('alpha test')).toHaveLength(0)
+    expect(manager.detectActivatedGroups('beta test')).toHaveLength(1)
+  })
+
+  it('re-embeds only the groups whose words changed', async () => {
+    const { manager, embedded } = createHarness()
+    manager.createGroup({ name: 'g1', words: ['alpha'] })
+    manager.createGroup({ name: 'g2', words: ['beta'] })
+
+    await manager.precomputeGroupVectors('test-model')
+    expect(embedded).toHaveLength(2)
+    expect(manager.hasStaleGroups()).toBe(false)
+    embedded.length = 0
+
+    // 只改权重不标脏
+    manager.updateGroup({ name: 'g2', weight: 2 })
+    expect(manager.hasStaleGroups()).toBe(false)
+
+    manager.updateGroup({ name: 'g1', words: ['alpha', 'gamma'] })
+    expect(manager.hasStaleGroups()).toBe(true)
+
+    const result = await manager.refreshStaleGroupVectors()
+    expect(result).toEqual({ updated: 1, failed: 0, errors: [] })
+    expect(embedded).toHaveLength(1)
+    expect(embedded[0]).toContain('g1')
+    expect(manager.hasStaleGroups()).toBe(false)
+  })
+
+  it('drains stale groups automatically after the debounce delay', async () => {
+    vi.useFakeTimers()
+    const { manager, embedded } = createHarness()
+    manager.createGroup({ name: 'g', words: ['alpha'] })
+    await manager.precomputeGroupVectors('test-model')
+    embedded.length = 0
+
+    manager.updateGroup({ name: 'g', words: ['beta'] })
+    manager.updateGroup({ name: 'g', words: ['beta', 'gamma'] })
+    expect(embedded).toHaveLength(0)
+
+    await vi.advanceTimersByTimeAsync(STALE_REFRESH_DELAY_MS)
+    expect(embedded).toHaveLength(1)
+    expect(manager.hasStaleGroups()).toBe(false)
+    expect(manager.getGroup('g')!.vectorId).toBeTruthy()
+  })
+
+  it('queues staleness until a model is known from a full precompute', async () => {
+    vi.useFakeTimers()
+    const { manager, embedded } = createHarness()
+    manager.createGroup({ name: 'g', words: ['alpha'] })
+
+    await vi.advanceTimersByTimeAsync(STALE_REFRESH_DELAY_MS * 2)
+    expect(embedded).toHaveLength(0)
+    expect(manager.hasStaleGroups()).toBe(true)
+    expect(await manager.refreshStaleGroupVectors()).toEqual({ updated: 0, failed: 0, errors: [] })
+    expect(manager.hasStaleGroups()).toBe(true)
+
+    await manager.precomputeGroupVectors('test-model')
+    expect(embedded).toHaveLength(1)
+    expect(manager.hasStaleGroups()).toBe(false)
+  })
+
+  it('drops pending staleness when a group is deleted', () => {
+    const { manager } = createHarness()
+    manager.createGroup({ name: 'g', words: ['alpha'] })
+    expect(manager.hasStaleGroups()).toBe(true)
+
+    manager.deleteGroup('g')
+    expect(manager.hasStaleGroups()).toBe(false)
+    expect(manager.getGroup('g')).toBeNull()
+  })
+})
@@ -3,7 +3,7 @@ import { existsSync, mkdirSync, mkdtempSync, readFileSync, rmSync, writeFileSync
 import { tmpdir } from 'node:os'
 import path from 'node:path'
 import packageJson from '../package.json'
-import { getSettings, initializeSettingsStore, setSettings } from '../electron/store'
+import { flushSettingsWrites, getSettings, initializeSettingsStore, setSettings } from '../electron/store'
 import { SETTINGS_FILE_NAME } from '../electron/settingsMigrationSafety'
 
 const root = mkdtempSync(path.join(tmpdir(), 'neodeskpet-store-init-'))
@@ -45,7 +45,13 @@ describe('settings store initialization', () => {
     expect(settings.petScale).toBe(1.5)
     expect(settings.bubble).toMatchObject({ positionX: 5, positionY: 10, showOnChat: false })
 
+    // 写入是防抖落盘的：setSettings 后内存立即可见，文件要等 flushSettingsWrites
     setSettings({ clickThrough: true })
+    expect(getSettings().clickThrough).toBe(true)
+    const beforeFlush = JSON.parse(readFileSync(settingsPath, 'utf8')) as { clickThrough?: boolean }
+    expect(beforeFlush.clickThrough).not.toBe(true)
+
+    flushSettingsWrites()
     const afterUserWrite = JSON.parse(readFileSync(settingsPath, 'utf8')) as {
       clickThrough: boolean
       __internal__: { migrations: { version: string } }
@@ -53,6 +59,13 @@ describe('settings store initialization', () => {
     expect(afterUserWrite.clickThrough).toBe(true)
     expect(afterUserWrite.__internal__.migrations.version).toBe(packageJson.version)
 
+    // 所有节都回到已落盘状态时，flush 跳过整次文件重写
+    setSettings({ clickThrough: false })
+    setSettings({ clickThrough: true })
+    const statBeforeNoopFlush = readFileSync(settingsPath, 'utf8')
+    flushSettingsWrites()
+    expect(readFileSync(settingsPath, 'utf8')).toBe(statBeforeNoopFlush)
+
     const second = initializeSettingsStore({
       userDataDir,
       targetVersion: packageJson.version,
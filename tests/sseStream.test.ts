@@ -0,0 +1,54 @@
+import { describe, expect, it } from 'vitest'
+import { SseStreamParser } from '../src/services/sseStream'
+
+const encoder = new TextEncoder()
+
+function pushAll(parser: SseStreamParser, text: string, chunkSize: number): string[] {
+  const bytes = encoder.encode(text)
+  const payloads: string[] = []
+  for (let i = 0; i < bytes.length; i += chunkSize) {
+    payloads.push(...parser.push(bytes.subarray(i, i + chunkSize)))
+  }
+  return payloads
+}
+
+describe('SSE stream parser', () => {
+  it('emits data payloads from complete lines and keeps the incomplete tail buffered', () => {
+    const parser = new SseStreamParser()
+    expect(parser.push(encoder.encode('data: par'))).toEqual([])
+    expect(parser.push(encoder.encode('tial\ndata: next\n'))).toEqual(['partial', 'next'])
+  })
+
+  it('handles CRLF endings and skips comments, other fields, and empty payloads', () => {
+    const parser = new SseStreamParser()
+    const payloads = parser.push(
+      encoder.encode('event: message\r\n: keep-alive comment\r\ndata:  hello \r\ndata:\r\n\r\ndata: world\n'),
+    )
+    expect(payloads).toEqual(['hello', 'world'])
+  })
+
+  it('decodes multi-byte UTF-8 payloads split across arbitrary chunk boundaries', () => {
+    const text = 'data: {"content":"你好，世界 🌏"}\n\ndata: [DONE]\n'
+    for (const chunkSize of [1, 2, 3, 7, 64]) {
+      expect(pushAll(new SseStreamParser(), text, chunkSize)).toEqual(['{"content":"你好，世界 🌏"}', '[DONE]'])
+    }
+  })
+
+  it('compacts the buffer so a long stream does not retain consumed input', () => {
+    const parser = new SseStreamParser()
+    const payloads: string[] = []
+    for (let i = 0; i < 5_000; i++) {
+      payloads.push(...parser.push(encoder.encode(`data: {"i":${i}}\n`)))
+    }
+    expect(payloads).toHaveLength(5_000)
+    expect(payloads[0]).toBe('{"i":0}')
+    expect(payloads[4_999]).toBe('{"i":4999}')
+  })
+
+  it('drops buffered input on reset', () => {
+    const parser = new SseStreamParser()
+    parser.push(encoder.encode('data: before-re'))
+    parser.reset()
+    expect(parser.push(encoder.encode('set\ndata: after\n'))).toEqual(['after'])
+  })
+})
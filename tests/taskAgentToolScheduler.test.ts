@@ -0,0 +1,154 @@
+import { describe, expect, it, vi } from 'vitest'
+import { planToolCallGroups, runToolCallBatch } from '../electron/task/taskAgentToolScheduler'
+
+type Call = { name: string }
+
+const serialNames = new Set(['file.write', 'cli.exec_stream'])
+const isSerial = (call: Call) => serialNames.has(call.name)
+
+function deferred<T>() {
+  let resolve!: (value: T) => void
+  let reject!: (err: unknown) => void
+  const promise = new Promise<T>((res, rej) => {
+    resolve = res
+    reject = rej
+  })
+  return { promise, resolve, reject }
+}
+
+describe('planToolCallGroups', () => {
+  it('merges consecutive parallel-safe calls and isolates serial-only calls', () => {
+    const calls: Call[] = [
+      { name: 'file.read' },
+      { name: 'browser.fetch' },
+      { name: 'file.write' },
+      { name: 'skill.list' },
+      { name: 'cli.exec_stream' },
+    ]
+    const groups = planToolCallGroups(calls, isSerial)
+    expect(groups.map((g) => ({ start: g.start, serial: g.serial, names: g.calls.map((c) => c.name) }))).toEqual([
+      { start: 0, serial: false, names: ['file.read', 'browser.fetch'] },
+      { start: 2, serial: true, names: ['file.write'] },
+      { start: 3, serial: false, names: ['skill.list'] },
+      { start: 4, serial: true, names: ['cli.exec_stream'] },
+    ])
+  })
+})
+
+describe('runToolCallBatch', () => {
+  it('runs independent calls concurrently and returns results in call order', async () => {
+    const gates = [deferred<string>(), deferred<string>(), deferred<string>()]
+    let active = 0
+    let peak = 0
+
+    const batch = runToolCallBatch<Call, string>(
+      [{ name: 'a' }, { name: 'b' }, { name: 'c' }],
+      {
+        isSerial: () => false,
+        execute: async (_call, index) => {
+          active += 1
+          peak = Math.max(peak, active)
+          try {
+            return await gates[index].promise
+          } finally {
+            active -= 1
+          }
+        },
+      },
+    )
+
+    // 后面的先完成也不影响结果顺序
+    gates[2].resolve('r3')
+    gates[0].resolve('r1')
+    gates[1].resolve('r2')
+    await expect(batch).resolves.toEqual(['r1', 'r2', 'r3'])
+    expect(peak).toBe(3)
+  })
+
+  it('honours the parallelism limit', async () => {
+    const gates = Array.from({ length: 5 }, () => deferred<string>())
+    let active = 0
+    let peak = 0
+
+    const batch = runToolCallBatch<Call, string>(
+      Array.from({ length: 5 }, (_, i) => ({ name: `t${i}` })),
+      {
+        isSerial: () => false,
+        maxParallel: 2,
+        execute: async (_call, index) => {
+          active += 1
+          peak = Math.max(peak, active)
+          try {
+            return await gates[index].promise
+          } finally {
+            active -= 1
+          }
+        },
+      },
+    )
+
+    for (const [i, gate] of gates.entries()) gate.resolve(`r${i}`)
+    await batch
+    expect(peak).toBe(2)
+  })
+
+  it('treats a serial-only call as a barrier between parallel groups', async () => {
+    const order: string[] = []
+    const results = await runToolCallBatch<Call, string>(
+      [{ name: 'file.read' }, { name: 'browser.fetch' }, { name: 'file.write' }, { name: 'skill.list' }],
+      {
+        isSerial,
+        execute: async (call) => {
+          order.push(`start:${call.name}`)
+          await Promise.resolve()
+          order.push(`end:${call.name}`)
+          return call.name
+        },
+      },
+    )
+
+    expect(results).toEqual(['file.read', 'browser.fetch', 'file.write', 'skill.list'])
+    // 屏障语义：file.write 必须等前一组全部结束才开始，skill.list 必须等它结束
+    expect(order.indexOf('start:file.write')).toBeGreaterThan(order.indexOf('end:file.read'))
+    expect(order.indexOf('start:file.write')).toBeGreaterThan(order.indexOf('end:browser.fetch'))
+    expect(order.indexOf('start:skill.list')).toBeGreaterThan(order.indexOf('end:file.write'))
+  })
+
+  it('reports the parallel group size only for groups with more than one call', async () => {
+    const onParallelGroup = vi.fn()
+    await runToolCallBatch<Call, string>(
+      [{ name: 'a' }, { name: 'b' }, { name: 'file.write' }, { name: 'c' }],
+      {
+        isSerial,
+        onParallelGroup,
+        execute: async (call) => call.name,
+      },
+    )
+    expect(onParallelGroup).toHaveBeenCalledTimes(1)
+    expect(onParallelGroup).toHaveBeenCalledWith(2)
+  })
+
+  it('waits for in-flight siblings, stops starting new calls, then rethrows the first error', async () => {
+    const gates = Array.from({ length: 4 }, () => deferred<string>())
+    const started: number[] = []
+
+    const batch = runToolCallBatch<Call, string>(
+      Array.from({ length: 4 }, (_, i) => ({ name: `t${i}` })),
+      {
+        isSerial: () => false,
+        maxParallel: 2,
+        execute: async (_call, index) => {
+          started.push(index)
+          return gates[index].promise
+        },
+      },
+    )
+
+    gates[0].reject(new Error('boom'))
+    // 让出错分支先被观察到，再放行在途的兄弟调用
+    await Promise.resolve()
+    gates[1].resolve('r1')
+    await expect(batch).rejects.toThrow('boom')
+    expect(started).toEqual([0, 1])
+  })
+})
@@ -0,0 +1,100 @@
+import { beforeEach, describe, expect, it } from 'vitest'
+import {
+  exportChromeTrace,
+  getTraceSnapshot,
+  recordEventLoopLag,
+  recordSpan,
+  resetTracingForTests,
+  startSpan,
+} from '../electron/tracing'
+
+describe('tracing', () => {
+  beforeEach(() => {
+    resetTracingForTests()
+  })
+
+  it('aggregates span durations into count, total, max and percentiles', () => {
+    for (let i = 1; i <= 100; i++) recordSpan('ipc', 'chat:list', i)
+
+    const snapshot = getTraceSnapshot()
+    const stat = snapshot.spans.find((span) => span.category === 'ipc' && span.name === 'chat:list')
+    expect(stat).toBeDefined()
+    expect(stat?.count).toBe(100)
+    expect(stat?.totalMs).toBe(5050)
+    expect(stat?.maxMs).toBe(100)
+    expect(stat?.p50Ms).toBe(50)
+    expect(stat?.p99Ms).toBe(99)
+  })
+
+  it('keeps percentiles over a rolling window so old outliers age out', () => {
+    recordSpan('tool', 'web.search', 10_000)
+    for (let i = 0; i < 256; i++) recordSpan('tool', 'web.search', 5)
+
+    const stat = getTraceSnapshot().spans.find((span) => span.name === 'web.search')
+    expect(stat?.count).toBe(257)
+    // 最早的 10s 离群值已被滚动窗口淘汰，但 max 保留终身峰值
+    expect(stat?.p99Ms).toBe(5)
+    expect(stat?.maxMs).toBe(10_000)
+  })
+
+  it('sorts snapshot spans by p99 descending', () => {
+    recordSpan('ipc', 'fast', 1)
+    recordSpan('ipc', 'slow', 50)
+    recordSpan('ipc', 'medium', 10)
+
+    const names = getTraceSnapshot().spans.map((span) => span.name)
+    expect(names).toEqual(['slow', 'medium', 'fast'])
+  })
+
+  it('records a span exactly once even if the end callback is called twice', () => {
+    const endSpan = startSpan('memory', 'retrieveContext')
+    endSpan()
+    endSpan()
+
+    const stat = getTraceSnapshot().spans.find((span) => span.name === 'retrieveContext')
+    expect(stat?.count).toBe(1)
+  })
+
+  it('aggregates event-loop lag per target and clamps invalid samples', () => {
+    recordEventLoopLag('main', 2)
+    recordEventLoopLag('main', 40)
+    recordEventLoopLag('main', -3)
+    recordEventLoopLag('main', Number.NaN)
+    recordEventLoopLag('renderer:pet', 7)
+
+    const snapshot = getTraceSnapshot()
+    expect(snapshot.eventLoop.map((lag) => lag.target)).toEqual(['main', 'renderer:pet'])
+    const main = snapshot.eventLoop[0]
+    expect(main.samples).toBe(4)
+    expect(main.maxMs).toBe(40)
+    const pet = snapshot.eventLoop[1]
+    expect(pet.samples).toBe(1)
+    expect(pet.p50Ms).toBe(7)
+  })
+
+  it('exports recent spans in Chrome trace event format', () => {
+    recordSpan('ipc', 'settings:get', 3)
+    recordSpan('tool', 'cli.exec', 120)
+
+    const parsed = JSON.parse(exportChromeTrace()) as {
+      traceEvents: Array<{ name: string; cat: string; ph: string; ts: number; dur: number; pid: number; tid: number }>
+      displayTimeUnit: string
+    }
+    expect(parsed.displayTimeUnit).toBe('ms')
+    expect(parsed.traceEvents).toHaveLength(2)
+    const toolEvent = parsed.traceEvents.find((event) => event.cat === 'tool')
+    expect(toolEvent?.name).toBe('cli.exec')
+    expect(toolEvent?.ph).toBe('X')
+    expect(toolEvent?.dur).toBe(120_000)
+    expect(toolEvent?.pid).toBe(process.pid)
+  })
+
+  it('drops the oldest exported events once the ring is full', () => {
+    for (let i = 0; i < 4_100; i++) recordSpan('ipc', `channel-${i}`, 1)
+
+    const parsed = JSON.parse(exportChromeTrace()) as { traceEvents: Array<{ name: string }> }
+    expect(parsed.traceEvents).toHaveLength(4_000)
+    expect(parsed.traceEvents[0].name).toBe('channel-100')
+    expect(parsed.traceEvents.at(-1)?.name).toBe('channel-4099')
+  })
+})
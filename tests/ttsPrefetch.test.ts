@@ -0,0 +1,112 @@
+import { describe, expect, it } from 'vitest'
+import { createTtsPrefetchPipeline } from '../src/services/ttsPrefetch'
+
+type Deferred = {
+  promise: Promise<string | null>
+  resolve: (audio: string | null) => void
+  reject: (err: unknown) => void
+}
+
+function deferred(): Deferred {
+  let resolve!: (audio: string | null) => void
+  let reject!: (err: unknown) => void
+  const promise = new Promise<string | null>((res, rej) => {
+    resolve = res
+    reject = rej
+  })
+  return { promise, resolve, reject }
+}
+
+/** 每次 synthesize 调用挂在一个可手动完成的 deferred 上，便于控制完成顺序 */
+function controlledSynth() {
+  const calls: Array<{ text: string; d: Deferred }> = []
+  const synthesize = (text: string) => {
+    const d = deferred()
+    calls.push({ text, d })
+    return d.promise
+  }
+  return { calls, synthesize }
+}
+
+describe('createTtsPrefetchPipeline', () => {
+  it('keeps at most maxAhead syntheses in flight', () => {
+    const { calls, synthesize } = controlledSynth()
+    const pipeline = createTtsPrefetchPipeline({ synthesize, maxAhead: 2 })
+
+    pipeline.push('一')
+    pipeline.push('二')
+    pipeline.push('三')
+    pipeline.push('四')
+
+    expect(calls.map((c) => c.text)).toEqual(['一', '二'])
+    expect(pipeline.inFlight()).toBe(2)
+  })
+
+  it('starts the next segment as soon as the head is taken', async () => {
+    const { calls, synthesize } = controlledSynth()
+    const pipeline = createTtsPrefetchPipeline({ synthesize, maxAhead: 2 })
+
+    pipeline.push('一')
+    pipeline.push('二')
+    pipeline.push('三')
+
+    // shift 取走队头后应立即补位：第三句在第一句还没合成完时就已在途
+    const head = pipeline.shift()
+    expect(calls.map((c) => c.text)).toEqual(['一', '二', '三'])
+
+    calls[0].d.resolve('audio-1')
+    expect(await head).toEqual({ text: '一', audio: 'audio-1', error: null })
+  })
+
+  it('delivers results in push order even when later segments finish first', async () => {
+    const { calls, synthesize } = controlledSynth()
+    const pipeline = createTtsPrefetchPipeline({ synthesize, maxAhead: 2 })
+
+    pipeline.push('一')
+    pipeline.push('二')
+
+    calls[1].d.resolve('audio-2')
+    calls[0].d.resolve('audio-1')
+
+    expect((await pipeline.shift())?.audio).toBe('audio-1')
+    expect((await pipeline.shift())?.audio).toBe('audio-2')
+  })
+
+  it('captures synthesis failures per segment instead of rejecting', async () => {
+    const { calls, synthesize } = controlledSynth()
+    const pipeline = createTtsPrefetchPipeline({ synthesize, maxAhead: 2 })
+
+    pipeline.push('一')
+    pipeline.push('二')
+    calls[0].d.reject(new Error('合成失败'))
+    calls[1].d.resolve('audio-2')
+
+    expect(await pipeline.shift()).toEqual({ text: '一', audio: null, error: '合成失败' })
+    expect((await pipeline.shift())?.audio).toBe('audio-2')
+  })
+
+  it('returns null from shift when nothing has been pushed', async () => {
+    const pipeline = createTtsPrefetchPipeline({ synthesize: async () => 'x' })
+    expect(await pipeline.shift()).toBeNull()
+  })
+
+  it('dispose drops the whole pipeline at once, including results already in flight', async () => {
+    const { calls, synthesize } = controlledSynth()
+    const pipeline = createTtsPrefetchPipeline({ synthesize, maxAhead: 2 })
+
+    pipeline.push('一')
+    pipeline.push('二')
+    pipeline.push('三')
+
+    const head = pipeline.shift()
+    pipeline.dispose()
+    calls[0].d.resolve('audio-1')
+
+    // 已在等待的 shift 在 dispose 后丢弃结果；之后 push/shift 都是空操作
+    expect(await head).toBeNull()
+    expect(pipeline.inFlight()).toBe(0)
+    pipeline.push('四')
+    expect(calls.map((c) => c.text)).toEqual(['一', '二', '三'])
+    expect(await pipeline.shift()).toBeNull()
+  })
+})
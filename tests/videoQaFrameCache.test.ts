@@ -0,0 +1,126 @@
+import { mkdtempSync, rmSync } from 'node:fs'
+import * as fs from 'node:fs/promises'
+import { tmpdir } from 'node:os'
+import path from 'node:path'
+import { afterEach, describe, expect, it } from 'vitest'
+import {
+  VideoQaFrameCache,
+  videoContentHash,
+  videoQaSamplingKey,
+  type VideoQaSamplingConfig,
+} from '../electron/videoQaFrameCache'
+
+const roots: string[] = []
+
+function makeRoot(): string {
+  const root = mkdtempSync(path.join(tmpdir(), 'neodeskpet-videoqa-cache-'))
+  roots.push(root)
+  return root
+}
+
+afterEach(() => {
+  for (const root of roots.splice(0)) rmSync(root, { recursive: true, force: true })
+})
+
+const config: VideoQaSamplingConfig = { segmentSeconds: 20, framesPerSegment: 3, maxSegments: 8, startSeconds: 0 }
+
+describe('videoContentHash', () => {
+  it('depends on content, not on path', async () => {
+    const root = makeRoot()
+    const payload = Buffer.from('fake video payload '.repeat(1000))
+    await fs.writeFile(path.join(root, 'a.mp4'), payload)
+    await fs.writeFile(path.join(root, 'b.mp4'), payload)
+    const a = await videoContentHash(path.join(root, 'a.mp4'))
+    const b = await videoContentHash(path.join(root, 'b.mp4'))
+    expect(a).toBe(b)
+    expect(a).toMatch(/^[0-9a-f]{24}$/)
+  })
+
+  it('changes when bytes or length change', async () => {
+    const root = makeRoot()
+    const payload = Buffer.from('fake video payload '.repeat(1000))
+    await fs.writeFile(path.join(root, 'a.mp4'), payload)
+    const base = await videoContentHash(path.join(root, 'a.mp4'))
+
+    const mutated = Buffer.from(payload)
+    mutated[Math.trunc(mutated.length / 2)] ^= 0xff
+    await fs.writeFile(path.join(root, 'b.mp4'), mutated)
+    expect(await videoContentHash(path.join(root, 'b.mp4'))).not.toBe(base)
+
+    await fs.writeFile(path.join(root, 'c.mp4'), Buffer.concat([payload, Buffer.from('x')]))
+    expect(await videoContentHash(path.join(root, 'c.mp4'))).not.toBe(base)
+  })
+})
+
+describe('videoQaSamplingKey', () => {
+  it('encodes every sampling parameter', () => {
+    expect(videoQaSamplingKey(config)).toBe('s20_f3_m8_t0')
+    expect(videoQaSamplingKey({ ...config, framesPerSegment: 4 })).toBe('s20_f4_m8_t0')
+  })
+})
+
+describe('VideoQaFrameCache', () => {
+  it('round-trips an extraction and restores absolute frame paths', async () => {
+    const cache = new VideoQaFrameCache({ cacheRoot: makeRoot() })
+    const dir = cache.cacheDirFor('hash1', config)
+    await fs.mkdir(dir, { recursive: true })
+    await fs.writeFile(path.join(dir, 'seg000_t0000010000.jpg'), 'jpg')
+    await fs.writeFile(path.join(dir, 'seg000_t0000016666.jpg'), 'jpg')
+
+    const extraction = {
+      durationSec: 42.5,
+      fps: 30,
+      segments: [
+        {
+          index: 0,
+          startSec: 0,
+          endSec: 20,
+          frames: [path.join(dir, 'seg000_t0000010000.jpg'), path.join(dir, 'seg000_t0000016666.jpg')],
+        },
+      ],
+    }
+    await cache.store('hash1', config, extraction)
+
+    const hit = await cache.lookup('hash1', config)
+    expect(hit).toEqual(extraction)
+  })
+
+  it('misses for a different sampling config or unknown hash', async () => {
+    const cache = new VideoQaFrameCache({ cacheRoot: makeRoot() })
+    const dir = cache.cacheDirFor('hash1', config)
+    await fs.mkdir(dir, { recursive: true })
+    await fs.writeFile(path.join(dir, 'f.jpg'), 'jpg')
+    await cache.store('hash1', config, {
+      durationSec: 1,
+      fps: 1,
+      segments: [{ index: 0, startSec: 0, endSec: 1, frames: [path.join(dir, 'f.jpg')] }],
+    })
+
+    expect(await cache.lookup('hash1', { ...config, segmentSeconds: 30 })).toBeNull()
+    expect(await cache.lookup('hash2', config)).toBeNull()
+  })
+
+  it('misses when a cached frame file disappeared', async () => {
+    const cache = new VideoQaFrameCache({ cacheRoot: makeRoot() })
+    const dir = cache.cacheDirFor('hash1', config)
+    await fs.mkdir(dir, { recursive: true })
+    await fs.writeFile(path.join(dir, 'f.jpg'), 'jpg')
+    await cache.store('hash1', config, {
+      durationSec: 1,
+      fps: 1,
+      segments: [{ index: 0, startSec: 0, endSec: 1, frames: [path.join(dir, 'f.jpg')] }],
+    })
+    await fs.rm(path.join(dir, 'f.jpg'))
+
+    expect(await cache.lookup('hash1', config)).toBeNull()
+  })
+
+  it('ignores a corrupted meta file', async () => {
+    const cache = new VideoQaFrameCache({ cacheRoot: makeRoot() })
+    const dir = cache.cacheDirFor('hash1', config)
+    await fs.mkdir(dir, { recursive: true })
+    await fs.writeFile(path.join(dir, 'meta.json'), '{not json')
+
+    expect(await cache.lookup('hash1', config)).toBeNull()
+  })
+})
@@ -0,0 +1,87 @@
+import { describe, expect, it } from 'vitest'
+import { resolveVirtualizedRange } from '../src/hooks/useVirtualizedMessageList'
+
+describe('virtualized message range', () => {
+  it('renders only the viewport plus overscan and pads the rest', () => {
+    const range = resolveVirtualizedRange({
+      count: 1500,
+      scrollTop: 50_000,
+      viewportHeight: 800,
+      estimatedHeight: 100,
+      overscanPx: 200,
+    })
+
+    expect(range.startIndex).toBe(498) // (50_000 - 200) / 100
+    expect(range.endIndex).toBe(510) // ceil((50_000 + 800 + 200) / 100)
+    expect(range.topPad).toBe(49_800)
+    expect(range.bottomPad).toBe(1500 * 100 - 51_000)
+    expect(range.totalHeight).toBe(150_000)
+  })
+
+  it('uses measured heights when available and keeps the total consistent', () => {
+    const heights = [50, 300, 50, 50]
+    const range = resolveVirtualizedRange({
+      count: 4,
+      scrollTop: 340,
+      viewportHeight: 60,
+      estimatedHeight: 100,
+      overscanPx: 0,
+      heightAt: (index) => heights[index],
+    })
+
+    expect(range.startIndex).toBe(1)
+    expect(range.endIndex).toBe(3)
+    expect(range.topPad).toBe(50)
+    expect(range.bottomPad).toBe(50)
+    expect(range.totalHeight).toBe(450)
+  })
+
+  it('accounts for the flex row gap between messages', () => {
+    const range = resolveVirtualizedRange({
+      count: 3,
+      scrollTop: 0,
+      viewportHeight: 1000,
+      estimatedHeight: 100,
+      rowGapPx: 6,
+    })
+
+    expect(range.startIndex).toBe(0)
+    expect(range.endIndex).toBe(3)
+    expect(range.totalHeight).toBe(312)
+  })
+
+  it('falls back to the tail window before the viewport is measured', () => {
+    const range = resolveVirtualizedRange({
+      count: 200,
+      scrollTop: 0,
+      viewportHeight: 0,
+      estimatedHeight: 100,
+    })
+
+    expect(range.startIndex).toBe(170)
+    expect(range.endIndex).toBe(200)
+    expect(range.bottomPad).toBe(0)
+    expect(range.topPad).toBe(17_000)
+  })
+
+  it('handles empty sessions and bottoms-out past the end', () => {
+    expect(resolveVirtualizedRange({ count: 0, scrollTop: 0, viewportHeight: 500 })).toEqual({
+      startIndex: 0,
+      endIndex: 0,
+      topPad: 0,
+      bottomPad: 0,
+      totalHeight: 0,
+    })
+
+    const past = resolveVirtualizedRange({
+      count: 5,
+      scrollTop: 10_000,
+      viewportHeight: 500,
+      estimatedHeight: 100,
+      overscanPx: 0,
+    })
+    expect(past.startIndex).toBe(5)
+    expect(past.endIndex).toBe(5)
+    expect(past.bottomPad).toBe(0)
+  })
+})
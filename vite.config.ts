@@ -32,11 +32,12 @@ export default defineConfig({
     react(),
     electron({
       main: {
-        // vectorSearchWorker 作为独立 entry 打包成 dist-electron/vectorSearchWorker.js，
-        // 供主进程以 worker_threads 启动（见 memoryService.ts）
+        // 工作线程作为独立 entry 打包到 dist-electron/，供主进程以 worker_threads 启动：
+        // vectorSearchWorker 见 memoryService.ts，chatStoreWorker 见 chatStoreJournal.ts
         entry: {
           main: 'electron/main.ts',
           vectorSearchWorker: 'electron/vectorSearchWorker.ts',
+          chatStoreWorker: 'electron/chatStoreWorker.ts',
         },
         vite: {
           build: {